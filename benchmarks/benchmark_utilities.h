@@ -0,0 +1,136 @@
+#ifndef ANALYZER_BENCHMARK_UTILITIES_H
+#define ANALYZER_BENCHMARK_UTILITIES_H
+
+#include "tracking-analyzer/synthetic_data.h"
+#include <QString>
+#include <QTemporaryFile>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace analyzer_benchmark
+{
+  // The seed is arbitrary; it just keeps the generated data the same from run
+  // to run. Every benchmark's data comes from it.
+  constexpr std::uint32_t seed {20211017};
+
+  // Get the options for a synthetic dataset with sequence_count sequences of
+  // frame_count frames, and results for tracker_count trackers.
+  [[nodiscard]] inline auto
+  make_options(const benchmark::IterationCount sequence_count,
+               const benchmark::IterationCount frame_count,
+               const benchmark::IterationCount tracker_count = 0)
+  {
+    analyzer::synthetic_options options;
+    options.sequence_count = static_cast<int>(sequence_count);
+    options.minimum_frame_count = static_cast<int>(frame_count);
+    options.maximum_frame_count = static_cast<int>(frame_count);
+    options.tracker_count = static_cast<int>(tracker_count);
+    options.seed = seed;
+    return options;
+  }
+
+  // The ground truth of one synthetic sequence, and one tracker's results for
+  // it.
+  struct box_lists final
+  {
+    analyzer::bounding_box_list ground_truth;
+    analyzer::bounding_box_list results;
+  };
+
+  [[nodiscard]] inline auto
+  make_box_lists(const benchmark::IterationCount count)
+  {
+    const auto options {make_options(1, count, 1)};
+    box_lists boxes {analyzer::make_synthetic_ground_truth(options, 0), {}};
+    boxes.results =
+      analyzer::make_synthetic_results(options, boxes.ground_truth, 0, 0);
+    return boxes;
+  }
+
+  // Write one tracker's results for one sequence of box_count frames under
+  // directory, and return the path of the results file.
+  inline auto write_box_file(const QString& directory,
+                             const benchmark::IterationCount box_count)
+  {
+    const auto root {directory.toStdString()};
+    analyzer::write_synthetic_results(root, make_options(1, box_count, 1));
+    return root + '/' + analyzer::synthetic_tracker_name(0) + '/'
+           + analyzer::synthetic_sequence_name(0) + ".txt";
+  }
+
+  [[nodiscard]] inline auto read_file(const std::string& path)
+  {
+    std::ifstream file {path};
+    if (!file)
+    {
+      throw std::runtime_error {"Cannot read " + path + '.'};
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    return text.str();
+  }
+
+  // Get the total size, in bytes, of the files under directory.
+  [[nodiscard]] inline auto directory_bytes(const QString& directory)
+  {
+    benchmark::IterationCount bytes {0};
+    for (const auto& entry : std::filesystem::recursive_directory_iterator {
+           directory.toStdString()})
+    {
+      if (entry.is_regular_file())
+      {
+        bytes += static_cast<benchmark::IterationCount>(entry.file_size());
+      }
+    }
+    return bytes;
+  }
+
+  // Write text to a temporary file, and return the file's path. The file is
+  // removed when file is destroyed.
+  inline auto write_temporary_file(QTemporaryFile& file,
+                                   const std::string& text)
+  {
+    if (!file.open())
+    {
+      throw std::runtime_error {"Cannot create a temporary file."};
+    }
+    file.write(text.data(), static_cast<qint64>(text.size()));
+    file.flush();
+    return file.fileName();
+  }
+
+  // Report throughput as items per second, given the number of items one
+  // iteration processes.
+  inline void set_throughput(benchmark::State& state,
+                             const benchmark::IterationCount items)
+  {
+    state.SetItemsProcessed(state.iterations() * items);
+  }
+
+  // Report throughput as items per second and bytes per second, given the
+  // number of items and bytes one iteration processes.
+  inline void set_throughput(benchmark::State& state,
+                             const benchmark::IterationCount items,
+                             const benchmark::IterationCount bytes)
+  {
+    set_throughput(state, items);
+    state.SetBytesProcessed(state.iterations() * bytes);
+  }
+
+  // Report throughput as items per second and bytes per second, given the
+  // number of items one iteration processes, and the text it reads.
+  inline void set_throughput(benchmark::State& state,
+                             const benchmark::IterationCount items,
+                             const std::string& text)
+  {
+    set_throughput(
+      state, items, static_cast<benchmark::IterationCount>(text.size()));
+  }
+}  // namespace analyzer_benchmark
+
+#endif
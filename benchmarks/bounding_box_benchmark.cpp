@@ -0,0 +1,111 @@
+#include "benchmark_utilities.h"
+#include "tracking-analyzer/bounding_box.h"
+#include <QStringList>
+#include <QTemporaryDir>
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <sstream>
+
+namespace analyzer_benchmark
+{
+  namespace
+  {
+    // This is the parser that read_bounding_boxes() used before the
+    // std::from_chars() parser. It's here to measure the difference.
+    auto legacy_read_bounding_boxes(std::istream& stream)
+    {
+      std::string line;
+      analyzer::bounding_box_list boxes;
+      while (std::getline(stream, line))
+      {
+        const auto strings {QString::fromStdString(line).split(',')};
+        boxes.push_back(analyzer::bounding_box {strings[0].toFloat(),
+                                                strings[1].toFloat(),
+                                                strings[2].toFloat(),
+                                                strings[3].toFloat()});
+      }
+      return boxes;
+    }
+
+    // This is how the tracking results loader read a sequence file before it
+    // used read_bounding_box_file().
+    auto legacy_read_result_file(const std::string& path)
+    {
+      QStringList lines;
+      std::string one_line;
+      std::ifstream file {path};
+      while (file >> one_line)
+      {
+        lines.append(QString::fromStdString(one_line));
+      }
+      analyzer::bounding_box_list boxes;
+      for (const auto& line : lines)
+      {
+        const auto numbers {line.split(",")};
+        boxes.push_back(analyzer::bounding_box {numbers.at(0).toFloat(),
+                                                numbers.at(1).toFloat(),
+                                                numbers.at(2).toFloat(),
+                                                numbers.at(3).toFloat()});
+      }
+      return boxes;
+    }
+
+    void legacy_parse(benchmark::State& state)
+    {
+      const QTemporaryDir directory;
+      const auto text {
+        read_file(write_box_file(directory.path(), state.range(0)))};
+      for ([[maybe_unused]] auto _ : state)
+      {
+        std::istringstream stream {text};
+        benchmark::DoNotOptimize(legacy_read_bounding_boxes(stream));
+      }
+      set_throughput(state, state.range(0), text);
+    }
+
+    void parse_bounding_boxes(benchmark::State& state)
+    {
+      const QTemporaryDir directory;
+      const auto text {
+        read_file(write_box_file(directory.path(), state.range(0)))};
+      for ([[maybe_unused]] auto _ : state)
+      {
+        benchmark::DoNotOptimize(analyzer::parse_bounding_boxes(text));
+      }
+      set_throughput(state, state.range(0), text);
+    }
+
+    void legacy_read_file(benchmark::State& state)
+    {
+      const QTemporaryDir directory;
+      const auto path {write_box_file(directory.path(), state.range(0))};
+      const auto text {read_file(path)};
+      for ([[maybe_unused]] auto _ : state)
+      {
+        benchmark::DoNotOptimize(legacy_read_result_file(path));
+      }
+      set_throughput(state, state.range(0), text);
+    }
+
+    void read_bounding_box_file(benchmark::State& state)
+    {
+      const QTemporaryDir directory;
+      const auto path {write_box_file(directory.path(), state.range(0))};
+      const auto text {read_file(path)};
+      for ([[maybe_unused]] auto _ : state)
+      {
+        benchmark::DoNotOptimize(analyzer::read_bounding_box_file(path));
+      }
+      set_throughput(state, state.range(0), text);
+    }
+  }  // namespace
+
+  // NOLINTNEXTLINE
+  BENCHMARK(legacy_parse)->RangeMultiplier(10)->Range(10, 100'000);
+  // NOLINTNEXTLINE
+  BENCHMARK(parse_bounding_boxes)->RangeMultiplier(10)->Range(10, 100'000);
+  // NOLINTNEXTLINE
+  BENCHMARK(legacy_read_file)->RangeMultiplier(10)->Range(10, 100'000);
+  // NOLINTNEXTLINE
+  BENCHMARK(read_bounding_box_file)->RangeMultiplier(10)->Range(10, 100'000);
+}  // namespace analyzer_benchmark
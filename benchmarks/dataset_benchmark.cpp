@@ -0,0 +1,90 @@
+#include "benchmark_utilities.h"
+#include "tracking-analyzer/dataset.h"
+#include <QTemporaryDir>
+#include <benchmark/benchmark.h>
+
+namespace analyzer_benchmark
+{
+  namespace
+  {
+    // Write a synthetic dataset with sequence_count sequences of frame_count
+    // frames. The frames are empty files; only the ground truth and
+    // attributes are read. Return the number of bytes written.
+    auto write_dataset(const QString& root,
+                       const benchmark::IterationCount sequence_count,
+                       const benchmark::IterationCount frame_count)
+    {
+      analyzer::write_synthetic_dataset(
+        root.toStdString(), make_options(sequence_count, frame_count));
+      return directory_bytes(root);
+    }
+
+    void load_dataset(benchmark::State& state, const analyzer::load_mode mode)
+    {
+      const QTemporaryDir directory;
+      const auto bytes {
+        write_dataset(directory.path(), state.range(0), state.range(1))};
+      analyzer::dataset_load_options options;
+      options.mode = mode;
+      for ([[maybe_unused]] auto _ : state)
+      {
+        analyzer::load_error_list skipped;
+        benchmark::DoNotOptimize(
+          analyzer::load_dataset(directory.path(), options, skipped));
+      }
+      // A lazy load only lists the sequence directories, so it's measured in
+      // sequences. An eager load is measured in frames and bytes.
+      if (mode == analyzer::load_mode::lazy)
+      {
+        set_throughput(state, state.range(0));
+      }
+      else
+      {
+        set_throughput(state, state.range(0) * state.range(1), bytes);
+      }
+    }
+
+    // Loading from the index reads the index file instead of the ground
+    // truth, so it's measured in frames.
+    void load_indexed_dataset(benchmark::State& state)
+    {
+      const QTemporaryDir directory;
+      const auto path {directory.path() + "/dataset"};
+      static_cast<void>(write_dataset(path, state.range(0), state.range(1)));
+      analyzer::dataset_load_options options;
+      options.index_path = directory.path() + "/index";
+      // Write the index, so every iteration reads from it.
+      analyzer::load_error_list skipped;
+      benchmark::DoNotOptimize(analyzer::load_dataset(path, options, skipped));
+      for ([[maybe_unused]] auto _ : state)
+      {
+        skipped.clear();
+        benchmark::DoNotOptimize(
+          analyzer::load_dataset(path, options, skipped));
+      }
+      set_throughput(state, state.range(0) * state.range(1));
+    }
+
+    // From 10 to 100,000 frames in all.
+    void dataset_sizes(benchmark::internal::Benchmark* benchmark)
+    {
+      benchmark->ArgNames({"sequences", "frames"});
+      benchmark->Args({1, 10});
+      benchmark->Args({10, 100});
+      benchmark->Args({100, 1'000});
+    }
+  }  // namespace
+
+  // NOLINTNEXTLINE
+  BENCHMARK_CAPTURE(load_dataset, eager, analyzer::load_mode::eager)
+    ->Apply(dataset_sizes)
+    ->Unit(benchmark::kMillisecond);
+  // NOLINTNEXTLINE
+  BENCHMARK_CAPTURE(load_dataset, lazy, analyzer::load_mode::lazy)
+    ->Apply(dataset_sizes)
+    ->Unit(benchmark::kMillisecond);
+  // NOLINTNEXTLINE
+  BENCHMARK(load_indexed_dataset)
+    ->Apply(dataset_sizes)
+    ->Unit(benchmark::kMillisecond);
+}  // namespace analyzer_benchmark
@@ -0,0 +1,116 @@
+#include "benchmark_utilities.h"
+#include "tracking-analyzer/box_array.h"
+#include "tracking-analyzer/overlap_kernels.h"
+#include <benchmark/benchmark.h>
+
+namespace analyzer_benchmark
+{
+  namespace
+  {
+    // Compare the scalar calculate_overlap() loop with the batch kernels. The
+    // boxes are a synthetic ground truth and a tracker's results for it, so
+    // the overlaps are spread like real ones.
+    void calculate_overlaps(benchmark::State& state,
+                            const analyzer::instruction_set isa)
+    {
+      if (!analyzer::is_supported(isa))
+      {
+        state.SkipWithError("This CPU does not support the instruction set.");
+        return;
+      }
+      const auto [a, b] {make_box_lists(state.range(0))};
+      analyzer::overlap_list overlaps(a.size());
+      for ([[maybe_unused]] auto _ : state)
+      {
+        analyzer::calculate_overlaps(a, b, overlaps, isa);
+        benchmark::DoNotOptimize(overlaps.data());
+        benchmark::ClobberMemory();
+      }
+      static constexpr benchmark::IterationCount bytes_per_pair {
+        2 * sizeof(analyzer::bounding_box)};
+      set_throughput(state, state.range(0), state.range(0) * bytes_per_pair);
+    }
+
+    // The same kernels, loading from box arrays instead of box lists.
+    void calculate_box_array_overlaps(benchmark::State& state,
+                                      const analyzer::instruction_set isa)
+    {
+      if (!analyzer::is_supported(isa))
+      {
+        state.SkipWithError("This CPU does not support the instruction set.");
+        return;
+      }
+      const auto boxes {make_box_lists(state.range(0))};
+      const analyzer::box_array a {boxes.ground_truth};
+      const analyzer::box_array b {boxes.results};
+      analyzer::overlap_list overlaps(a.size());
+      for ([[maybe_unused]] auto _ : state)
+      {
+        analyzer::calculate_overlaps(a, b, overlaps, isa);
+        benchmark::DoNotOptimize(overlaps.data());
+        benchmark::ClobberMemory();
+      }
+      set_throughput(state, state.range(0));
+    }
+
+    // Compare the center offsets for box lists and box arrays.
+    void calculate_offsets(benchmark::State& state)
+    {
+      const auto [a, b] {make_box_lists(state.range(0))};
+      for ([[maybe_unused]] auto _ : state)
+      {
+        benchmark::DoNotOptimize(analyzer::calculate_offsets(a, b));
+      }
+      set_throughput(state, state.range(0));
+    }
+
+    void calculate_box_array_offsets(benchmark::State& state)
+    {
+      const auto boxes {make_box_lists(state.range(0))};
+      const analyzer::box_array a {boxes.ground_truth};
+      const analyzer::box_array b {boxes.results};
+      for ([[maybe_unused]] auto _ : state)
+      {
+        benchmark::DoNotOptimize(analyzer::calculate_offsets(a, b));
+      }
+      set_throughput(state, state.range(0));
+    }
+  }  // namespace
+
+  // NOLINTNEXTLINE
+  BENCHMARK_CAPTURE(calculate_overlaps,
+                    scalar,
+                    analyzer::instruction_set::scalar)
+    ->RangeMultiplier(10)
+    ->Range(10, 100'000);
+  // NOLINTNEXTLINE
+  BENCHMARK_CAPTURE(calculate_overlaps,
+                    sse2,
+                    analyzer::instruction_set::sse2)
+    ->RangeMultiplier(10)
+    ->Range(10, 100'000);
+  // NOLINTNEXTLINE
+  BENCHMARK_CAPTURE(calculate_overlaps,
+                    avx2,
+                    analyzer::instruction_set::avx2)
+    ->RangeMultiplier(10)
+    ->Range(10, 100'000);
+  // NOLINTNEXTLINE
+  BENCHMARK_CAPTURE(calculate_box_array_overlaps,
+                    sse2,
+                    analyzer::instruction_set::sse2)
+    ->RangeMultiplier(10)
+    ->Range(10, 100'000);
+  // NOLINTNEXTLINE
+  BENCHMARK_CAPTURE(calculate_box_array_overlaps,
+                    avx2,
+                    analyzer::instruction_set::avx2)
+    ->RangeMultiplier(10)
+    ->Range(10, 100'000);
+  // NOLINTNEXTLINE
+  BENCHMARK(calculate_offsets)->RangeMultiplier(10)->Range(10, 100'000);
+  // NOLINTNEXTLINE
+  BENCHMARK(calculate_box_array_offsets)
+    ->RangeMultiplier(10)
+    ->Range(10, 100'000);
+}  // namespace analyzer_benchmark
@@ -0,0 +1,92 @@
+#include "benchmark_utilities.h"
+#include "tracking-analyzer/tracking_results.h"
+#include <QTemporaryDir>
+#include <benchmark/benchmark.h>
+
+namespace analyzer_benchmark
+{
+  namespace
+  {
+    constexpr int sequence_count {100};
+
+    // Write synthetic results for tracker_count trackers, each with
+    // sequence_count sequences of box_count boxes. Return the number of bytes
+    // written.
+    auto write_results_directory(const QString& root,
+                                 const benchmark::IterationCount tracker_count,
+                                 const benchmark::IterationCount box_count)
+    {
+      analyzer::write_synthetic_results(
+        root.toStdString(),
+        make_options(sequence_count, box_count, tracker_count));
+      return directory_bytes(root);
+    }
+
+    // Report throughput as boxes per second and bytes per second.
+    void set_results_throughput(benchmark::State& state,
+                                const benchmark::IterationCount bytes)
+    {
+      set_throughput(
+        state, state.range(0) * sequence_count * state.range(1), bytes);
+    }
+
+    void load_without_cache(benchmark::State& state)
+    {
+      const QTemporaryDir directory;
+      const auto bytes {write_results_directory(
+        directory.path(), state.range(0), state.range(1))};
+      const auto path {directory.path().toStdString()};
+      for ([[maybe_unused]] auto _ : state)
+      {
+        analyzer::load_error_list errors;
+        benchmark::DoNotOptimize(
+          analyzer::load_tracking_results_directory(path, 0, errors));
+      }
+      set_results_throughput(state, bytes);
+    }
+
+    void load_with_cache(benchmark::State& state)
+    {
+      const QTemporaryDir directory;
+      const auto bytes {write_results_directory(
+        directory.path() + "/results", state.range(0), state.range(1))};
+      const auto path {directory.path().toStdString() + "/results"};
+      const auto cache_path {directory.path().toStdString() + "/cache"};
+      // Warm the cache, so every iteration reads from it.
+      analyzer::load_error_list errors;
+      benchmark::DoNotOptimize(analyzer::load_tracking_results_directory(
+        path, cache_path, 0, errors));
+      for ([[maybe_unused]] auto _ : state)
+      {
+        errors.clear();
+        benchmark::DoNotOptimize(analyzer::load_tracking_results_directory(
+          path, cache_path, 0, errors));
+      }
+      set_results_throughput(state, bytes);
+    }
+
+    // Scale the sequence length with one tracker, from 1,000 to 100,000
+    // frames in all. Then scale the number of trackers at a typical length.
+    void results_sizes(benchmark::internal::Benchmark* benchmark)
+    {
+      benchmark->ArgNames({"trackers", "boxes"});
+      for (const auto box_count : {10, 100, 1'000})
+      {
+        benchmark->Args({1, box_count});
+      }
+      for (const auto tracker_count : {10, 100})
+      {
+        benchmark->Args({tracker_count, 100});
+      }
+    }
+  }  // namespace
+
+  // NOLINTNEXTLINE
+  BENCHMARK(load_without_cache)
+    ->Apply(results_sizes)
+    ->Unit(benchmark::kMillisecond);
+  // NOLINTNEXTLINE
+  BENCHMARK(load_with_cache)
+    ->Apply(results_sizes)
+    ->Unit(benchmark::kMillisecond);
+}  // namespace analyzer_benchmark
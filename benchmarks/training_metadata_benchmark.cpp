@@ -0,0 +1,123 @@
+#include "benchmark_utilities.h"
+#include "tracking-analyzer/training_metadata.h"
+#include <QTemporaryFile>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <sstream>
+
+namespace analyzer_benchmark
+{
+  namespace
+  {
+    constexpr int update_count {10};
+    constexpr int batches_per_update {4};
+    constexpr int lists_per_batch {3};
+
+    void write_scores(std::ostream& json,
+                      std::mt19937& generator,
+                      const benchmark::IterationCount score_count)
+    {
+      std::uniform_real_distribution<float> score {-150.0f, 150.0f};
+      json << '[';
+      for (benchmark::IterationCount i {0}; i < score_count; ++i)
+      {
+        json << (i == 0 ? "" : ",") << '[' << score(generator) << ','
+             << score(generator) << ']';
+      }
+      json << ']';
+    }
+
+    // Make a training score file with update_count updates of
+    // batches_per_update batches. Each batch has score_count scores in each
+    // of its lists.
+    auto make_training_json(const benchmark::IterationCount score_count)
+    {
+      std::mt19937 generator {seed};
+      std::ostringstream json;
+      json << R"({"sequence": "Deer", "dataset": "OTB-100", "data": {)";
+      for (int u {0}; u < update_count; ++u)
+      {
+        json << (u == 0 ? "" : ",") << '"' << u * 10 << R"(": [)";
+        for (int b {0}; b < batches_per_update; ++b)
+        {
+          json << (b == 0 ? "" : ",") << R"({"background candidates": )";
+          write_scores(json, generator, score_count);
+          json << R"(, "background mined": )";
+          write_scores(json, generator, score_count);
+          json << R"(, "target candidates": )";
+          write_scores(json, generator, score_count);
+          json << R"(, "thresholds": [0, 0]})";
+        }
+        json << ']';
+      }
+      json << "}}";
+      return json.str();
+    }
+
+    // Report throughput as scores per second and bytes per second, for
+    // reading every batch in the file.
+    void set_file_throughput(benchmark::State& state, const std::string& json)
+    {
+      set_throughput(
+        state,
+        update_count * batches_per_update * lists_per_batch * state.range(0),
+        json);
+    }
+
+    void load_training_scores(benchmark::State& state)
+    {
+      const auto json {make_training_json(state.range(0))};
+      QTemporaryFile file;
+      const auto path {write_temporary_file(file, json)};
+      for ([[maybe_unused]] auto _ : state)
+      {
+        benchmark::DoNotOptimize(analyzer::load_training_scores(path));
+      }
+      set_file_throughput(state, json);
+    }
+
+    // Opening the index reads the whole file, but doesn't keep any scores.
+    void index_training_scores(benchmark::State& state)
+    {
+      const auto json {make_training_json(state.range(0))};
+      QTemporaryFile file;
+      const auto path {write_temporary_file(file, json)};
+      for ([[maybe_unused]] auto _ : state)
+      {
+        const analyzer::training_score_index index {path};
+        benchmark::DoNotOptimize(index.update_count());
+      }
+      set_file_throughput(state, json);
+    }
+
+    // Parse one batch on demand. The cache holds one batch, and the
+    // iterations alternate between two batches, so every request parses.
+    void parse_training_batch(benchmark::State& state)
+    {
+      const auto json {make_training_json(state.range(0))};
+      QTemporaryFile file;
+      const auto path {write_temporary_file(file, json)};
+      analyzer::training_score_index index {path, 1};
+      analyzer::update_list::size_type update {0};
+      for ([[maybe_unused]] auto _ : state)
+      {
+        benchmark::DoNotOptimize(&index.batch({update, 0}));
+        update = 1 - update;
+      }
+      set_throughput(state, lists_per_batch * state.range(0));
+    }
+  }  // namespace
+
+  // NOLINTNEXTLINE
+  BENCHMARK(load_training_scores)
+    ->RangeMultiplier(10)
+    ->Range(10, 10'000)
+    ->Unit(benchmark::kMillisecond);
+  // NOLINTNEXTLINE
+  BENCHMARK(index_training_scores)
+    ->RangeMultiplier(10)
+    ->Range(10, 10'000)
+    ->Unit(benchmark::kMillisecond);
+  // NOLINTNEXTLINE
+  BENCHMARK(parse_training_batch)->RangeMultiplier(10)->Range(10, 10'000);
+}  // namespace analyzer_benchmark
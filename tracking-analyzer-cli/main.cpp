@@ -0,0 +1,139 @@
+#include "tracking-analyzer/dataset.h"
+#include "tracking-analyzer/evaluation.h"
+#include "tracking-analyzer/evaluation_report.h"
+#include "tracking-analyzer/filesystem.h"
+#include "tracking-analyzer/tracking_results.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+
+namespace
+{
+  void report_skipped(const analyzer::load_error_list& skipped)
+  {
+    for (const auto& error : skipped)
+    {
+      std::cerr << "skipped " << error.path << ": " << error.message << '\n';
+    }
+  }
+
+  void write_report(const QString& output_path, const QByteArray& report)
+  {
+    QFile output {output_path};
+    const auto opened {output_path.isEmpty()
+                         ? output.open(stdout, QIODevice::WriteOnly)
+                         : output.open(QIODevice::WriteOnly)};
+    if (!opened || output.write(report) != report.size())
+    {
+      throw std::runtime_error {"cannot write the report: "
+                                + output.errorString().toStdString()};
+    }
+  }
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+  const QCoreApplication application {argc, argv};
+  QCoreApplication::setApplicationName("tracking-analyzer-cli");
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+    "Evaluate tracking results against a dataset, and write the success and "
+    "precision scores as JSON.");
+  parser.addHelpOption();
+  parser.addPositionalArgument("dataset", "The dataset directory.");
+  parser.addPositionalArgument("results", "The tracking results directory.");
+  const QCommandLineOption output_option {
+    QStringList {"o", "output"},
+    "Write the report to <file> instead of standard output.",
+    "file"};
+  const QCommandLineOption jobs_option {
+    QStringList {"j", "jobs"},
+    "Use at most <count> threads. Zero uses every core.",
+    "count",
+    "0"};
+  const QCommandLineOption index_option {
+    "index", "Read and write the dataset index at <file>.", "file"};
+  const QCommandLineOption rebuild_index_option {
+    "rebuild-index", "Ignore the dataset index, and rewrite it."};
+  const QCommandLineOption cache_option {
+    "cache", "Read and write the tracking results cache at <file>.", "file"};
+  parser.addOptions({output_option,
+                     jobs_option,
+                     index_option,
+                     rebuild_index_option,
+                     cache_option});
+  parser.process(application);
+  const auto arguments {parser.positionalArguments()};
+  if (arguments.size() != 2)
+  {
+    std::cerr << "expected a dataset directory and a results directory\n";
+    parser.showHelp(EXIT_FAILURE);
+  }
+  bool valid_jobs {false};
+  const auto worker_count {parser.value(jobs_option).toUInt(&valid_jobs)};
+  if (!valid_jobs)
+  {
+    std::cerr << "--jobs must be a non-negative integer\n";
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    analyzer::dataset_load_options options;
+    options.worker_count = worker_count;
+    options.index_path = parser.value(index_option);
+    options.rebuild_index = parser.isSet(rebuild_index_option);
+    analyzer::load_error_list skipped;
+    std::optional<analyzer::load_error> index_error;
+    const auto data {
+      analyzer::load_dataset(arguments[0], options, skipped, index_error)};
+    if (index_error)
+    {
+      // Without an index, the next run reads the dataset directory again.
+      std::cerr << "warning: " << index_error->path << ": "
+                << index_error->message << '\n';
+    }
+    if (data.sequences().isEmpty())
+    {
+      report_skipped(skipped);
+      std::cerr << "the dataset " << arguments[0].toStdString()
+                << " has no valid sequences\n";
+      return EXIT_FAILURE;
+    }
+    const auto results_path {
+      analyzer::make_absolute_path(arguments[1]).toStdString()};
+    const auto results {
+      parser.isSet(cache_option)
+        ? analyzer::load_tracking_results_directory(
+          results_path,
+          parser.value(cache_option).toStdString(),
+          worker_count,
+          skipped)
+        : analyzer::load_tracking_results_directory(
+          results_path, worker_count, skipped)};
+    if (results.trackers().empty())
+    {
+      report_skipped(skipped);
+      std::cerr << "the results directory " << results_path
+                << " has no tracking results\n";
+      return EXIT_FAILURE;
+    }
+    // A tracker with the wrong number of boxes for a sequence is skipped, so
+    // it doesn't stop the other trackers from being evaluated.
+    const auto evaluations {
+      analyzer::evaluate(results, data, worker_count, skipped)};
+    report_skipped(skipped);
+    write_report(parser.value(output_option),
+                 analyzer::make_evaluation_report(evaluations, skipped));
+  }
+  catch (const std::exception& error)
+  {
+    std::cerr << error.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+#include "tracking-analyzer/synthetic_data.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+  auto to_unsigned(const QCommandLineParser& parser,
+                   const QCommandLineOption& option)
+  {
+    bool valid {false};
+    const auto value {parser.value(option).toUInt(&valid)};
+    if (!valid)
+    {
+      throw std::invalid_argument {"--" + option.names().last().toStdString()
+                                   + " must be a non-negative integer."};
+    }
+    return value;
+  }
+
+  auto to_int(const QCommandLineParser& parser,
+              const QCommandLineOption& option)
+  {
+    bool valid {false};
+    const auto value {parser.value(option).toInt(&valid)};
+    if (!valid)
+    {
+      throw std::invalid_argument {"--" + option.names().last().toStdString()
+                                   + " must be an integer."};
+    }
+    return value;
+  }
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+  const QCoreApplication application {argc, argv};
+  QCoreApplication::setApplicationName("tracking-analyzer-generator");
+  const analyzer::synthetic_options defaults;
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+    "Write a synthetic dataset in the OTB layout, and optionally tracking "
+    "results for it. The same options always write the same data.\n\n"
+    "For a production-scale test of about 1,400 sequences, 3 million frames, "
+    "and 200 trackers, use\n"
+    "  --sequences 1400 --min-frames 300 --max-frames 3986 --trackers 200");
+  parser.addHelpOption();
+  parser.addPositionalArgument("dataset", "The dataset directory to write.");
+  parser.addPositionalArgument(
+    "results", "The tracking results directory to write.", "[results]");
+  const QCommandLineOption sequences_option {
+    "sequences",
+    "Write <count> sequences.",
+    "count",
+    QString::number(defaults.sequence_count)};
+  const QCommandLineOption minimum_frames_option {
+    "min-frames",
+    "Make sequences at least <count> frames long.",
+    "count",
+    QString::number(defaults.minimum_frame_count)};
+  const QCommandLineOption maximum_frames_option {
+    "max-frames",
+    "Make sequences at most <count> frames long.",
+    "count",
+    QString::number(defaults.maximum_frame_count)};
+  const QCommandLineOption trackers_option {
+    "trackers",
+    "Write results for <count> trackers.",
+    "count",
+    QString::number(defaults.tracker_count)};
+  const QCommandLineOption width_option {
+    "width",
+    "Make the frames <pixels> wide.",
+    "pixels",
+    QString::number(defaults.frame_width)};
+  const QCommandLineOption height_option {
+    "height",
+    "Make the frames <pixels> high.",
+    "pixels",
+    QString::number(defaults.frame_height)};
+  const QCommandLineOption seed_option {
+    "seed",
+    "Make the random choices from <seed>.",
+    "seed",
+    QString::number(defaults.seed)};
+  const QCommandLineOption jobs_option {
+    QStringList {"j", "jobs"},
+    "Use at most <count> threads. Zero uses every core.",
+    "count",
+    "0"};
+  parser.addOptions({sequences_option,
+                     minimum_frames_option,
+                     maximum_frames_option,
+                     trackers_option,
+                     width_option,
+                     height_option,
+                     seed_option,
+                     jobs_option});
+  parser.process(application);
+  const auto arguments {parser.positionalArguments()};
+  if (arguments.isEmpty() || arguments.size() > 2)
+  {
+    std::cerr << "expected a dataset directory, and optionally a results "
+                 "directory\n";
+    parser.showHelp(EXIT_FAILURE);
+  }
+
+  try
+  {
+    analyzer::synthetic_options options;
+    options.sequence_count = to_int(parser, sequences_option);
+    options.minimum_frame_count = to_int(parser, minimum_frames_option);
+    options.maximum_frame_count = to_int(parser, maximum_frames_option);
+    options.tracker_count = to_int(parser, trackers_option);
+    options.frame_width = to_int(parser, width_option);
+    options.frame_height = to_int(parser, height_option);
+    options.seed = to_unsigned(parser, seed_option);
+    options.worker_count = to_unsigned(parser, jobs_option);
+    analyzer::write_synthetic_dataset(arguments[0].toStdString(), options);
+    if (arguments.size() == 2)
+    {
+      analyzer::write_synthetic_results(arguments[1].toStdString(), options);
+    }
+  }
+  catch (const std::exception& error)
+  {
+    std::cerr << error.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -1,5 +1,13 @@
 #include "application.h"
+#include "function_task.h"
+#include "tracking-analyzer/dataset_index.h"
 #include "tracking-analyzer/filesystem.h"
+#include "tracking-analyzer/parallel.h"
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <algorithm>
+#include <gsl/gsl_util>
+#include <utility>
 
 namespace analyzer::gui
 {
@@ -10,6 +18,15 @@ namespace analyzer::gui
     // organization. No need to set them here.
     QGuiApplication::setApplicationDisplayName("Tracking Analyzer");
     QCoreApplication::setApplicationVersion("0.0");
+    // One dataset warms up at a time; the warm-up runs its own workers.
+    m_dataset_pool.setMaxThreadCount(1);
+  }
+
+  application::~application()
+  {
+    // Don't wait for sequences that haven't started loading.
+    *m_stop_warm_up = true;
+    m_dataset_pool.waitForDone();
   }
 
   auto application::instance() -> gsl::not_null<application*>
@@ -24,24 +41,114 @@ namespace analyzer::gui
 
   auto application::settings() -> QSettings& { return instance()->m_settings; }
 
-  void application::load_dataset(const QString& dataset_path)
+  auto application::worker_count() -> unsigned int
   {
-    const auto app {application::instance()};
-    app->dataset() = analyzer::load_dataset(dataset_path);
-    app->settings().setValue(settings_keys::last_loaded_dataset, dataset_path);
+    // Zero lets the library pick the number of threads.
+    return settings().value(settings_keys::worker_count, 0u).toUInt();
+  }
+
+  auto application::frame_cache_budget() -> std::size_t
+  {
+    // The budget is in bytes. 512 MiB holds about 145 decoded 720p frames.
+    constexpr qulonglong default_budget {512ull * 1024ull * 1024ull};
+    return gsl::narrow_cast<std::size_t>(
+      settings()
+        .value(settings_keys::frame_cache_budget, default_budget)
+        .toULongLong());
+  }
+
+  auto application::lazy_dataset_loading() -> bool
+  {
+    return settings().value(settings_keys::lazy_dataset_loading, true).toBool();
   }
 
-  auto application::frame_image(const int sequence_index, const int frame_index)
-    -> QImage
+  auto application::load_dataset(const QString& dataset_path)
+    -> analyzer::load_error_list
   {
-    const auto frame_path {
-      application::dataset()[sequence_index][frame_index].image_path};
-    QImage frame {QString::fromStdString(frame_path)};
-    if (frame.format() != QImage::Format_RGB32)
+    const auto app {application::instance()};
+    *app->m_stop_warm_up = true;
+    app->m_stop_warm_up = std::make_shared<std::atomic<bool>>(false);
+    dataset_load_options options;
+    options.worker_count = worker_count();
+    options.index_path = dataset_index_path(dataset_path);
+    if (lazy_dataset_loading())
+    {
+      options.mode = load_mode::lazy;
+    }
+    analyzer::load_error_list skipped;
+    app->dataset() = analyzer::load_dataset(dataset_path, options, skipped);
+    const auto& sequences {app->dataset().sequences()};
+    const auto all_loaded {
+      std::all_of(std::begin(sequences),
+                  std::end(sequences),
+                  [](const analyzer::sequence& s) { return s.is_loaded(); })};
+    if (!all_loaded)
     {
-      frame = frame.convertToFormat(QImage::Format_RGB32);
+      start_warm_up(options.index_path, skipped);
     }
-    return frame;
+    // The cached metrics were measured against the old ground truth.
+    app->tracking_results().reset_metrics();
+    app->settings().setValue(settings_keys::last_loaded_dataset, dataset_path);
+    return skipped;
+  }
+
+  void application::start_warm_up(const QString& index_path,
+                                  const analyzer::load_error_list& skipped)
+  {
+    // The task holds a copy of the dataset, and copies of a sequence share
+    // the loaded data, so the task is safe even if the dataset is replaced.
+    // It runs at low priority, so it doesn't compete with the user.
+    const auto app {application::instance()};
+    app->m_dataset_pool.start(new function_task {
+      [data = app->dataset(),
+       stop = app->m_stop_warm_up,
+       index_path,
+       skipped,
+       workers = worker_count()]() {
+        const auto& sequences {data.sequences()};
+        analyzer::parallel_for(
+          gsl::narrow_cast<std::size_t>(sequences.size()),
+          workers,
+          [&sequences, &stop](const std::size_t i) {
+            if (*stop)
+            {
+              return;
+            }
+            try
+            {
+              sequences[gsl::narrow_cast<int>(i)].load();
+            }
+            catch (const analyzer::invalid_sequence&)
+            {
+              // The error is reported if the user selects the sequence.
+            }
+          });
+        if (*stop)
+        {
+          return;
+        }
+        try
+        {
+          analyzer::write_dataset_index(index_path, data, skipped);
+        }
+        catch (const std::runtime_error&)
+        {
+          // Without an index, the next load reads the dataset directory.
+        }
+      },
+      QThread::LowPriority});
+  }
+
+  auto application::dataset_index_path(const QString& dataset_path)
+    -> QString
+  {
+    // Name the index after a hash of the dataset directory, so each dataset
+    // gets its own index file.
+    const auto hash {QCryptographicHash::hash(
+      analyzer::make_absolute_path(dataset_path).toUtf8(),
+      QCryptographicHash::Sha1)};
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+           + "/datasets/" + QString::fromLatin1(hash.toHex()) + ".index";
   }
 
   auto application::ground_truth_bounding_box(int sequence_index,
@@ -62,21 +169,50 @@ namespace analyzer::gui
     return instance()->m_tracking_results;
   }
 
-  void application::load_tracking_results(const QString& results_path)
+  auto application::results_cache_path(const QString& results_path)
+    -> QString
+  {
+    // Name the cache after a hash of the results directory, so each results
+    // directory gets its own cache file.
+    const auto hash {QCryptographicHash::hash(
+      analyzer::make_absolute_path(results_path).toUtf8(),
+      QCryptographicHash::Sha1)};
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+           + "/results/" + QString::fromLatin1(hash.toHex()) + ".cache";
+  }
+
+  auto application::load_tracking_results(const QString& results_path)
+    -> analyzer::load_error_list
   {
     const auto app {application::instance()};
+    analyzer::load_error_list errors;
     app->tracking_results() = analyzer::load_tracking_results_directory(
-      analyzer::make_absolute_path(results_path).toStdString());
+      analyzer::make_absolute_path(results_path).toStdString(),
+      results_cache_path(results_path).toStdString(),
+      application::worker_count(),
+      errors);
     app->settings().setValue(settings_keys::last_loaded_results_directory,
                              results_path);
+    return errors;
   }
 
   auto application::tracking_result_bounding_box(
-    const std::string& tracker_name,
-    const std::string& sequence_name,
+    const results_database::size_type tracker_id,
+    const tracker_results::size_type sequence_id,
     const bounding_box_list::size_type frame_index) -> analyzer::bounding_box
   {
-    return application::tracking_results()[tracker_name][sequence_name]
-                                          [frame_index];
+    return std::as_const(application::tracking_results())[tracker_id]
+                                                         [sequence_id]
+                                                         [frame_index];
+  }
+
+  auto application::tracking_result_metrics(
+    const results_database::size_type tracker_id,
+    const tracker_results::size_type sequence_id,
+    const int sequence_index) -> const analyzer::frame_metrics&
+  {
+    return std::as_const(application::tracking_results())[tracker_id]
+                                                         [sequence_id]
+      .metrics(application::dataset()[sequence_index].target_box_array());
   }
 }  // namespace analyzer::gui
@@ -4,8 +4,10 @@
 #include "tracking-analyzer/dataset.h"
 #include "tracking-analyzer/tracking_results.h"
 #include <QApplication>
-#include <QImage>
 #include <QSettings>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
 #include <gsl/pointers>
 
 namespace analyzer::gui
@@ -15,39 +17,71 @@ namespace analyzer::gui
     static constexpr auto last_loaded_dataset {"recent/dataset_path"};
     static constexpr auto last_loaded_results_directory {
       "recent/results_directory"};
+    static constexpr auto last_loaded_training_scores {
+      "recent/training_scores"};
     static constexpr auto window_geometry {"window/geometry"};
     static constexpr auto window_state {"window/state"};
+    static constexpr auto worker_count {"performance/worker_count"};
+    static constexpr auto frame_cache_budget {
+      "performance/frame_cache_budget"};
+    static constexpr auto lazy_dataset_loading {
+      "performance/lazy_dataset_loading"};
   }  // namespace settings_keys
 
   class application final: public QApplication
   {
   public:
     application(int& argc, char** argv);
+    application(const application&) = delete;
+    application(application&&) = delete;
+    auto operator=(const application&) = delete;
+    auto operator=(application&&) = delete;
+    ~application() override;
     [[nodiscard]] static auto instance() -> gsl::not_null<application*>;
 
     [[nodiscard]] static auto dataset() -> analyzer::dataset&;
-    static void load_dataset(const QString& dataset_path);
-    [[nodiscard]] static auto frame_image(int sequence_index, int frame_index)
-      -> QImage;
+    static auto load_dataset(const QString& dataset_path)
+      -> analyzer::load_error_list;
     [[nodiscard]] static auto ground_truth_bounding_box(int sequence_index,
                                                         int frame_index)
       -> analyzer::bounding_box;
     [[nodiscard]] static auto dataset_loaded() -> bool;
 
     [[nodiscard]] static auto settings() -> QSettings&;
+    [[nodiscard]] static auto worker_count() -> unsigned int;
+    [[nodiscard]] static auto frame_cache_budget() -> std::size_t;
+    [[nodiscard]] static auto lazy_dataset_loading() -> bool;
 
     [[nodiscard]] static auto tracking_results() -> analyzer::results_database&;
-    static void load_tracking_results(const QString& results_path);
+    static auto load_tracking_results(const QString& results_path)
+      -> analyzer::load_error_list;
+    [[nodiscard]] static auto results_cache_path(const QString& results_path)
+      -> QString;
+    [[nodiscard]] static auto dataset_index_path(const QString& dataset_path)
+      -> QString;
     [[nodiscard]] static auto
-    tracking_result_bounding_box(const std::string& tracker_name,
-                                 const std::string& sequence_name,
+    tracking_result_bounding_box(results_database::size_type tracker_id,
+                                 tracker_results::size_type sequence_id,
                                  bounding_box_list::size_type frame_index)
       -> analyzer::bounding_box;
+    [[nodiscard]] static auto
+    tracking_result_metrics(results_database::size_type tracker_id,
+                            tracker_results::size_type sequence_id,
+                            int sequence_index)
+      -> const analyzer::frame_metrics&;
 
   private:
     analyzer::dataset m_dataset;
     QSettings m_settings;
     analyzer::results_database m_tracking_results;
+
+    // Loads lazy sequences in the background, before the user selects them,
+    // then indexes the dataset. Each dataset gets a new stop flag.
+    QThreadPool m_dataset_pool;
+    std::shared_ptr<std::atomic<bool>> m_stop_warm_up {
+      std::make_shared<std::atomic<bool>>(false)};
+    static void start_warm_up(const QString& index_path,
+                              const analyzer::load_error_list& skipped);
   };
 }  // namespace analyzer::gui
 
@@ -0,0 +1,99 @@
+#include "frame_cache.h"
+#include <gsl/gsl_util>
+
+namespace analyzer::gui
+{
+  namespace
+  {
+    // QImage::sizeInBytes() needs Qt 5.10, and QImage::byteCount() is
+    // deprecated from then on.
+    [[nodiscard]] auto image_size_bytes(const QImage& image)
+    {
+      return gsl::narrow_cast<std::size_t>(image.bytesPerLine())
+             * gsl::narrow_cast<std::size_t>(image.height());
+    }
+  }  // namespace
+
+  frame_cache::frame_cache(const std::size_t byte_budget):
+    m_byte_budget {byte_budget}
+  {
+  }
+
+  auto frame_cache::find(const frame_key& key) -> std::optional<QImage>
+  {
+    const auto i {m_index.constFind(key)};
+    if (i == m_index.constEnd())
+    {
+      ++m_statistics.misses;
+      return std::nullopt;
+    }
+    ++m_statistics.hits;
+    m_entries.splice(std::begin(m_entries), m_entries, *i);
+    return (*i)->image;
+  }
+
+  auto frame_cache::contains(const frame_key& key) const -> bool
+  {
+    return m_index.contains(key);
+  }
+
+  void frame_cache::insert(const frame_key& key, const QImage& image)
+  {
+    if (const auto i {m_index.constFind(key)}; i != m_index.constEnd())
+    {
+      m_size_bytes -= (*i)->size_bytes;
+      m_entries.erase(*i);
+    }
+    m_entries.push_front(entry {key, image, image_size_bytes(image)});
+    m_index.insert(key, std::begin(m_entries));
+    m_size_bytes += m_entries.front().size_bytes;
+    evict();
+  }
+
+  void frame_cache::clear()
+  {
+    m_entries.clear();
+    m_index.clear();
+    m_size_bytes = 0;
+  }
+
+  void frame_cache::set_byte_budget(const std::size_t byte_budget)
+  {
+    m_byte_budget = byte_budget;
+    evict();
+  }
+
+  auto frame_cache::byte_budget() const noexcept -> std::size_t
+  {
+    return m_byte_budget;
+  }
+
+  auto frame_cache::size_bytes() const noexcept -> std::size_t
+  {
+    return m_size_bytes;
+  }
+
+  auto frame_cache::size() const noexcept -> std::size_t
+  {
+    return m_entries.size();
+  }
+
+  auto frame_cache::statistics() const noexcept
+    -> const frame_cache_statistics&
+  {
+    return m_statistics;
+  }
+
+  void frame_cache::evict()
+  {
+    // Stop at one frame, so the most recently used frame stays.
+    while (m_size_bytes > m_byte_budget && m_entries.size() > 1)
+    {
+      const auto& oldest {m_entries.back()};
+      m_size_bytes -= oldest.size_bytes;
+      m_index.remove(oldest.key);
+      m_entries.pop_back();
+      ++m_statistics.evictions;
+    }
+  }
+}  // namespace analyzer::gui
@@ -0,0 +1,114 @@
+#ifndef ANALYZER_GUI_FRAME_CACHE_H
+#define ANALYZER_GUI_FRAME_CACHE_H
+
+#include <QHash>
+#include <QImage>
+#include <QPair>
+#include <cstddef>
+#include <list>
+#include <optional>
+
+namespace analyzer::gui
+{
+  /// Identify a frame by the index of its sequence in the dataset, and its
+  /// index in the sequence.
+  struct frame_key final
+  {
+    int sequence {0};
+    int frame {0};
+  };
+
+  [[nodiscard]] inline auto operator==(const frame_key& a,
+                                       const frame_key& b) noexcept
+  {
+    return a.sequence == b.sequence && a.frame == b.frame;
+  }
+
+  [[nodiscard]] inline auto qHash(const frame_key& key, const uint seed = 0)
+    -> uint
+  {
+    return ::qHash(qMakePair(key.sequence, key.frame), seed);
+  }
+
+  /// Count how well a frame_cache is working.
+  struct frame_cache_statistics final
+  {
+    std::size_t hits {0};
+    std::size_t misses {0};
+    std::size_t evictions {0};
+  };
+
+  /**
+   * \brief Keep the most recently used decoded frames, up to a memory budget.
+   * \details When adding a frame would take the cache over its budget, the
+   * least recently used frames are evicted. The frame just added is always
+   * kept, even if it's larger than the whole budget, so the frame on display
+   * is never evicted out from under the display.
+   */
+  class frame_cache final
+  {
+  public:
+    /**
+     * \brief Construct an empty cache.
+     * \param[in] byte_budget The maximum number of bytes of pixel data to keep.
+     */
+    explicit frame_cache(std::size_t byte_budget);
+
+    /**
+     * \brief Get a frame, and mark it as the most recently used.
+     * \param[in] key The frame to get.
+     * \return The frame image, or std::nullopt if the frame isn't cached.
+     *    Either outcome is counted in the statistics.
+     */
+    [[nodiscard]] auto find(const frame_key& key) -> std::optional<QImage>;
+
+    /// Check if a frame is cached, without counting it in the statistics or
+    /// changing its place in the eviction order.
+    [[nodiscard]] auto contains(const frame_key& key) const -> bool;
+
+    /**
+     * \brief Add a frame to the cache, or replace it if it's already cached.
+     * \param[in] key The frame to add.
+     * \param[in] image The decoded frame image.
+     */
+    void insert(const frame_key& key, const QImage& image);
+
+    /// Remove every frame. The statistics are not reset.
+    void clear();
+
+    /// Change the budget, evicting frames if the cache is over the new one.
+    void set_byte_budget(std::size_t byte_budget);
+
+    [[nodiscard]] auto byte_budget() const noexcept -> std::size_t;
+
+    /// Get the number of bytes of pixel data in the cache.
+    [[nodiscard]] auto size_bytes() const noexcept -> std::size_t;
+
+    /// Get the number of frames in the cache.
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    [[nodiscard]] auto statistics() const noexcept
+      -> const frame_cache_statistics&;
+
+  private:
+    struct entry final
+    {
+      frame_key key;
+      QImage image;
+      std::size_t size_bytes;
+    };
+    using entry_list = std::list<entry>;
+
+    void evict();
+
+    std::size_t m_byte_budget;
+    std::size_t m_size_bytes {0};
+
+    // The front of the list is the most recently used frame.
+    entry_list m_entries;
+    QHash<frame_key, entry_list::iterator> m_index;
+    frame_cache_statistics m_statistics;
+  };
+}  // namespace analyzer::gui
+
+#endif
@@ -0,0 +1,174 @@
+#include "frame_loader.h"
+#include "function_task.h"
+#include <algorithm>
+#include <gsl/gsl_util>
+
+namespace analyzer::gui
+{
+  namespace
+  {
+    // Load the requested frame before any of the prefetched frames.
+    constexpr int requested_priority {1};
+    constexpr int prefetch_priority {0};
+  }  // namespace
+
+  auto load_frame_image(const QString& path) -> QImage
+  {
+    QImage frame {path};
+    if (frame.format() != QImage::Format_RGB32)
+    {
+      frame = frame.convertToFormat(QImage::Format_RGB32);
+    }
+    return frame;
+  }
+
+  frame_loader::frame_loader(const unsigned int worker_count,
+                             const std::size_t cache_budget,
+                             QObject* parent):
+    QObject {parent}, m_cache {cache_budget}
+  {
+    if (worker_count > 0)
+    {
+      m_pool.setMaxThreadCount(gsl::narrow<int>(worker_count));
+    }
+    connect(this,
+            &frame_loader::frame_decoded,
+            this,
+            &frame_loader::store,
+            Qt::QueuedConnection);
+  }
+
+  frame_loader::~frame_loader()
+  {
+    // Workers use the loader's members, so they must finish first.
+    m_pool.clear();
+    m_pool.waitForDone();
+  }
+
+  void frame_loader::set_sequence(const int sequence_index,
+                                  const analyzer::frame_path_list& frame_paths)
+  {
+    // Frames waiting for a thread are removed from the pool, so they're no
+    // longer pending. Frames already being decoded still go in the cache.
+    m_pool.clear();
+    m_pending.clear();
+    m_sequence = sequence_index;
+    m_frame_paths = frame_paths;
+    m_current = 0;
+    m_direction = 1;
+    m_window_first = 0;
+    m_window_last = -1;
+  }
+
+  void frame_loader::clear()
+  {
+    // Sequence indices mean different sequences in the new dataset, so
+    // frames still being decoded must not go in the cache.
+    ++m_generation;
+    set_sequence(-1, {});
+    m_cache.clear();
+  }
+
+  auto frame_loader::cache() const noexcept -> const frame_cache&
+  {
+    return m_cache;
+  }
+
+  auto frame_loader::frame(const int frame_index) -> std::optional<QImage>
+  {
+    if (frame_index != m_current)
+    {
+      m_direction = frame_index < m_current ? -1 : 1;
+      m_current = frame_index;
+    }
+    const auto last_frame {m_frame_paths.size() - 1};
+    const auto behind {m_direction > 0 ? frames_behind : frames_ahead};
+    const auto ahead {m_direction > 0 ? frames_ahead : frames_behind};
+    m_window_first = std::max(0, m_current - behind);
+    m_window_last = std::min(last_frame, m_current + ahead);
+    auto image {m_cache.find(frame_key {m_sequence, frame_index})};
+    prefetch();
+    return image;
+  }
+
+  auto frame_loader::in_window(const int frame_index) const noexcept -> bool
+  {
+    return frame_index >= m_window_first && frame_index <= m_window_last;
+  }
+
+  void frame_loader::prefetch()
+  {
+    load(m_current, requested_priority);
+    for (int i {1}; i <= frames_ahead; ++i)
+    {
+      load(m_current + m_direction * i, prefetch_priority);
+    }
+    for (int i {1}; i <= frames_behind; ++i)
+    {
+      load(m_current - m_direction * i, prefetch_priority);
+    }
+  }
+
+  void frame_loader::load(const int frame_index, const int priority)
+  {
+    const frame_key key {m_sequence, frame_index};
+    if (!in_window(frame_index) || m_cache.contains(key)
+        || m_pending.contains(key))
+    {
+      return;
+    }
+    m_pending.insert(key);
+    const auto path {m_frame_paths[frame_index]};
+    const auto generation {m_generation};
+    m_pool.start(
+      new function_task {[this, generation, key, path]() {
+        // By the time a thread is free, the user may have moved on.
+        if (key.sequence != m_sequence || !in_window(key.frame))
+        {
+          emit frame_decoded(
+            generation, key.sequence, key.frame, QImage {}, false, {});
+          return;
+        }
+        emit frame_decoded(generation,
+                           key.sequence,
+                           key.frame,
+                           load_frame_image(path),
+                           true,
+                           {});
+      }},
+      priority);
+  }
+
+  void frame_loader::store(const int generation,
+                           const int sequence_index,
+                           const int frame_index,
+                           const QImage& image,
+                           const bool decoded)
+  {
+    if (generation != m_generation)
+    {
+      return;
+    }
+    const frame_key key {sequence_index, frame_index};
+    m_pending.remove(key);
+    if (decoded)
+    {
+      m_cache.insert(key, image);
+    }
+    if (sequence_index != m_sequence)
+    {
+      return;
+    }
+    if (!decoded)
+    {
+      // The window may have moved back over this frame after the worker
+      // skipped it.
+      load(frame_index,
+           frame_index == m_current ? requested_priority : prefetch_priority);
+    }
+    else if (frame_index == m_current)
+    {
+      emit frame_loaded(frame_index);
+    }
+  }
+}  // namespace analyzer::gui
@@ -0,0 +1,127 @@
+#ifndef ANALYZER_GUI_FRAME_LOADER_H
+#define ANALYZER_GUI_FRAME_LOADER_H
+
+#include "frame_cache.h"
+#include "tracking-analyzer/frame_path_list.h"
+#include <QImage>
+#include <QObject>
+#include <QSet>
+#include <QThreadPool>
+#include <atomic>
+#include <optional>
+
+namespace analyzer::gui
+{
+  /**
+   * \brief Read a frame image, in the format the frame display draws on.
+   * \param[in] path The path to the image file.
+   * \return The image, converted to QImage::Format_RGB32. If the file cannot
+   *    be read, the image is null.
+   */
+  [[nodiscard]] auto load_frame_image(const QString& path) -> QImage;
+
+  /**
+   * \brief Decode the frames of a sequence on worker threads.
+   * \details The loader decodes a window of frames around the most recently
+   * requested frame. The window extends further in the direction the user is
+   * moving through the sequence, so scrubbing forward or backward finds the
+   * next frames already decoded. Decoded frames go into a frame_cache, so
+   * returning to a frame, or to a sequence, doesn't decode it again.
+   *
+   * Decoded frames are handed to the GUI thread as implicitly shared QImage
+   * objects, so returning a frame doesn't copy its pixels.
+   */
+  class frame_loader final: public QObject
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  public:
+    /// The number of frames to decode ahead of the requested frame.
+    static constexpr int frames_ahead {8};
+
+    /// The number of frames to keep behind the requested frame.
+    static constexpr int frames_behind {4};
+
+    /**
+     * \brief Construct a frame loader with no frames.
+     * \param[in] worker_count The maximum number of decoding threads. Zero
+     *    means use as many threads as the hardware supports.
+     * \param[in] cache_budget The maximum number of bytes of decoded frames
+     *    to keep.
+     * \param[in] parent The Qt parent of the loader.
+     */
+    frame_loader(unsigned int worker_count,
+                 std::size_t cache_budget,
+                 QObject* parent = nullptr);
+    frame_loader(const frame_loader&) = delete;
+    frame_loader(frame_loader&&) = delete;
+    auto operator=(const frame_loader&) = delete;
+    auto operator=(frame_loader&&) = delete;
+    ~frame_loader() override;
+
+    /**
+     * \brief Change the sequence to load frames from.
+     * \param[in] sequence_index The index of the sequence in the dataset.
+     * \param[in] frame_paths The paths to the frame images of the sequence.
+     * \details Cached frames of other sequences are kept. Frames of other
+     * sequences that are waiting for a thread are not decoded.
+     */
+    void set_sequence(int sequence_index,
+                      const analyzer::frame_path_list& frame_paths);
+
+    /// Remove every cached frame, for example when a new dataset is loaded.
+    void clear();
+
+    /// Get read-only access to the frame cache, for its statistics.
+    [[nodiscard]] auto cache() const noexcept -> const frame_cache&;
+
+    /**
+     * \brief Get a decoded frame, and prefetch the frames around it.
+     * \param[in] frame_index The 0-based index of the frame.
+     * \return The frame image, or std::nullopt if the frame isn't decoded yet.
+     *    In that case, frame_loaded() is emitted when it is. If the frame
+     *    image cannot be read, the image is null.
+     */
+    [[nodiscard]] auto frame(int frame_index) -> std::optional<QImage>;
+
+  signals:
+    /// Emitted when the most recently requested frame finishes decoding.
+    void frame_loaded(int frame_index);
+
+    /// Emitted by a worker thread when it finishes with a frame. If the frame
+    /// was no longer wanted, \a decoded is false and \a image is null.
+    void frame_decoded(int generation,
+                       int sequence_index,
+                       int frame_index,
+                       const QImage& image,
+                       bool decoded,
+                       QPrivateSignal);
+
+  private:
+    [[nodiscard]] auto in_window(int frame_index) const noexcept -> bool;
+    void prefetch();
+    void load(int frame_index, int priority);
+    void store(int generation,
+               int sequence_index,
+               int frame_index,
+               const QImage& image,
+               bool decoded);
+
+    QThreadPool m_pool;
+    frame_cache m_cache;
+    analyzer::frame_path_list m_frame_paths;
+    QSet<frame_key> m_pending;
+    int m_generation {0};
+    int m_current {0};
+    int m_direction {1};
+
+    // Workers read these to skip frames that are no longer wanted by the time
+    // a thread is free to decode them.
+    std::atomic<int> m_sequence {-1};
+    std::atomic<int> m_window_first {0};
+    std::atomic<int> m_window_last {-1};
+  };
+}  // namespace analyzer::gui
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef ANALYZER_GUI_FUNCTION_TASK_H
+#define ANALYZER_GUI_FUNCTION_TASK_H
+
+#include <QRunnable>
+#include <QThread>
+#include <functional>
+#include <gsl/gsl_util>
+#include <utility>
+
+namespace analyzer::gui
+{
+  /// Run a function on a QThreadPool. QThreadPool only accepts functions
+  /// directly in Qt 5.15 and later.
+  class function_task final: public QRunnable
+  {
+  public:
+    /**
+     * \brief Wrap a function in a task.
+     * \param[in] task The function to run.
+     * \param[in] priority The priority of the pool thread while \a task runs.
+     *    InheritPriority leaves the thread's priority alone.
+     */
+    explicit function_task(
+      std::function<void()> task,
+      const QThread::Priority priority = QThread::InheritPriority):
+      m_task {std::move(task)}, m_priority {priority}
+    {
+    }
+
+    void run() override
+    {
+      if (m_priority == QThread::InheritPriority)
+      {
+        m_task();
+        return;
+      }
+      // Pool threads are reused, so put the priority back afterward. A pool
+      // thread reports InheritPriority until it's changed, and that can't be
+      // set on a running thread.
+      auto* const thread {QThread::currentThread()};
+      const auto previous {thread->priority() == QThread::InheritPriority
+                             ? QThread::NormalPriority
+                             : thread->priority()};
+      thread->setPriority(m_priority);
+      const auto restore {
+        gsl::finally([thread, previous]() { thread->setPriority(previous); })};
+      m_task();
+    }
+
+  private:
+    std::function<void()> m_task;
+    QThread::Priority m_priority;
+  };
+}  // namespace analyzer::gui
+
+#endif
@@ -0,0 +1,204 @@
+#include "frame_view.h"
+#include <QPainter>
+#include <QPen>
+#include <algorithm>
+#include <limits>
+
+namespace analyzer::gui
+{
+  namespace
+  {
+    void draw_boxes(QPainter& painter,
+                    const bounding_box_list& boxes,
+                    const std::vector<QColor>& colors)
+    {
+      painter.setBrush(Qt::NoBrush);
+      QPen pen {Qt::red};
+      pen.setWidth(2);
+      for (bounding_box_list::size_type i {0};
+           i < std::min(colors.size(), boxes.size());
+           ++i)
+      {
+        pen.setColor(colors[i]);
+        painter.setPen(pen);
+        const auto box {boxes.at(i)};
+        painter.drawRect(QRectF {box.x, box.y, box.width, box.height});
+      }
+    }
+
+    constexpr int path_width {3};
+    constexpr int opaque_alpha {255};
+    constexpr int quarter_alpha {64};
+    // I found 12 for the pen width by trial and error.
+    constexpr int point_width {12};
+
+    auto make_layer(const QSize& size)
+    {
+      QPixmap layer {size};
+      layer.fill(Qt::transparent);
+      return layer;
+    }
+
+    // Draw the lines through points [first, last) of each path.
+    void draw_path_segments(QPixmap& layer,
+                            const std::vector<QPolygonF>& paths,
+                            const std::vector<QColor>& colors,
+                            const int first,
+                            const int last,
+                            const int alpha)
+    {
+      QPainter painter {&layer};
+      painter.setBrush(Qt::NoBrush);
+      QPen pen;
+      pen.setWidth(path_width);
+      const auto count {std::min(colors.size(), paths.size())};
+      for (std::vector<QPolygonF>::size_type i {0}; i < count; ++i)
+      {
+        const auto& path {paths[i]};
+        const auto end {std::min(last, path.size())};
+        if (end - first < 2)
+        {
+          continue;
+        }
+        auto color {colors[i]};
+        color.setAlpha(alpha);
+        pen.setColor(color);
+        painter.setPen(pen);
+        painter.drawPolyline(&path[first], end - first);
+      }
+    }
+
+    void draw_current_points(QPainter& painter,
+                             const std::vector<QPolygonF>& paths,
+                             const std::vector<QColor>& colors,
+                             const int current_frame)
+    {
+      QPen pen;
+      pen.setWidth(point_width);
+      pen.setCapStyle(Qt::RoundCap);
+      const auto count {std::min(colors.size(), paths.size())};
+      for (std::vector<QPolygonF>::size_type i {0}; i < count; ++i)
+      {
+        if (current_frame < paths[i].size())
+        {
+          pen.setColor(colors[i]);
+          painter.setPen(pen);
+          painter.drawPoint(paths[i][current_frame]);
+        }
+      }
+    }
+  }  // namespace
+
+  frame_view::frame_view(QWidget* parent): QWidget {parent} {}
+
+  void frame_view::set_frame(const QImage& frame)
+  {
+    // The frame loader hands out shared copies of cached frames. If this is
+    // the frame already on display, there's nothing to convert.
+    if (frame.isNull() || frame.cacheKey() != m_frame_key)
+    {
+      m_frame = QPixmap::fromImage(frame);
+      m_frame_key = frame.cacheKey();
+    }
+    update();
+  }
+
+  void frame_view::clear()
+  {
+    m_frame = QPixmap {};
+    m_frame_key = 0;
+    m_overlay = overlay_type::none;
+    m_boxes.clear();
+    m_paths.clear();
+    m_colors.clear();
+    m_future_layer = QPixmap {};
+    update();
+  }
+
+  void frame_view::set_boxes(const bounding_box_list& boxes,
+                             const std::vector<QColor>& colors)
+  {
+    m_overlay = overlay_type::boxes;
+    m_boxes = boxes;
+    m_paths.clear();
+    m_colors = colors;
+    update();
+  }
+
+  void frame_view::set_paths(const std::vector<QPolygonF>& paths,
+                             const std::vector<QColor>& colors,
+                             const int current_frame)
+  {
+    m_overlay = overlay_type::paths;
+    m_boxes.clear();
+    // Paths from the same cache share their data, so this comparison is
+    // cheap when only the current frame changed.
+    if (paths != m_paths || colors != m_colors)
+    {
+      m_paths = paths;
+      m_colors = colors;
+      m_future_layer = QPixmap {};
+    }
+    m_current_frame = current_frame;
+    update();
+  }
+
+  void frame_view::update_path_layers()
+  {
+    // The future layer has every path, faintly. It only changes with the
+    // paths, or when a frame of a different size arrives.
+    if (m_future_layer.size() != m_frame.size())
+    {
+      m_future_layer = make_layer(m_frame.size());
+      draw_path_segments(m_future_layer,
+                         m_paths,
+                         m_colors,
+                         0,
+                         std::numeric_limits<int>::max(),
+                         quarter_alpha);
+      m_past_frame = -1;
+    }
+    // The past layer has the paths up to the current frame. Moving forward
+    // only adds the new segments. Moving backward has to start over.
+    if (m_past_frame < 0 || m_past_frame > m_current_frame)
+    {
+      m_past_layer = make_layer(m_frame.size());
+      m_past_frame = 0;
+    }
+    if (m_past_frame < m_current_frame)
+    {
+      draw_path_segments(m_past_layer,
+                         m_paths,
+                         m_colors,
+                         std::max(m_past_frame - 1, 0),
+                         m_current_frame,
+                         opaque_alpha);
+      m_past_frame = m_current_frame;
+    }
+  }
+
+  void frame_view::paintEvent([[maybe_unused]] QPaintEvent* event)
+  {
+    QPainter painter {this};
+    if (m_frame.isNull())
+    {
+      painter.drawText(rect(), Qt::AlignCenter, "No Sequence Loaded");
+      return;
+    }
+    // Center the frame, like a QLabel with centered alignment.
+    painter.translate((width() - m_frame.width()) / 2,
+                      (height() - m_frame.height()) / 2);
+    painter.drawPixmap(0, 0, m_frame);
+    if (m_overlay == overlay_type::boxes)
+    {
+      draw_boxes(painter, m_boxes, m_colors);
+    }
+    else if (m_overlay == overlay_type::paths)
+    {
+      update_path_layers();
+      painter.drawPixmap(0, 0, m_future_layer);
+      painter.drawPixmap(0, 0, m_past_layer);
+      draw_current_points(painter, m_paths, m_colors, m_current_frame);
+    }
+  }
+}  // namespace analyzer::gui
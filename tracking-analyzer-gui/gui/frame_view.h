@@ -0,0 +1,89 @@
+#ifndef ANALYZER_GUI_FRAME_VIEW_H
+#define ANALYZER_GUI_FRAME_VIEW_H
+
+#include "tracking-analyzer/bounding_box.h"
+#include <QColor>
+#include <QImage>
+#include <QPixmap>
+#include <QPolygonF>
+#include <QWidget>
+#include <vector>
+
+namespace analyzer::gui
+{
+  /**
+   * \brief Display a video frame with tracking results drawn over it.
+   * \details The frame and the overlay are separate layers. The frame is
+   * converted to a pixmap once, when it changes. Changing the overlay only
+   * repaints the widget, which copies the pixmap and draws the boxes or paths
+   * on top of it; nothing is drawn into the frame itself. The overlay uses
+   * frame coordinates.
+   *
+   * Paths are drawn into two more layers, which are kept between frames: the
+   * whole paths faintly, and the paths up to the current frame opaquely.
+   * Stepping forward through the frames only adds the newest segments to the
+   * opaque layer.
+   */
+  class frame_view final: public QWidget
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  public:
+    explicit frame_view(QWidget* parent = nullptr);
+
+    /// Show a new frame. The overlay is kept until it's replaced.
+    void set_frame(const QImage& frame);
+
+    /// Remove the frame and the overlay, and show a placeholder message.
+    void clear();
+
+    /**
+     * \brief Draw bounding boxes over the frame.
+     * \param[in] boxes The boxes to draw.
+     * \param[in] colors The color for each box in \a boxes.
+     */
+    void set_boxes(const bounding_box_list& boxes,
+                   const std::vector<QColor>& colors);
+
+    /**
+     * \brief Draw tracking paths over the frame.
+     * \param[in] paths The center of the target in each frame, for each path.
+     * \param[in] colors The color for each path in \a paths.
+     * \param[in] current_frame The frame on display. The path up to this frame
+     *    is opaque, the rest of the path is faint, and this frame's point is
+     *    highlighted.
+     */
+    void set_paths(const std::vector<QPolygonF>& paths,
+                   const std::vector<QColor>& colors,
+                   int current_frame);
+
+  protected:
+    void paintEvent(QPaintEvent* event) override;
+
+  private:
+    void update_path_layers();
+
+    enum class overlay_type
+    {
+      none,
+      boxes,
+      paths
+    };
+
+    QPixmap m_frame;
+    qint64 m_frame_key {0};
+
+    overlay_type m_overlay {overlay_type::none};
+    bounding_box_list m_boxes;
+    std::vector<QPolygonF> m_paths;
+    std::vector<QColor> m_colors;
+    int m_current_frame {0};
+
+    QPixmap m_future_layer;
+    QPixmap m_past_layer;
+    int m_past_frame {-1};
+  };
+}  // namespace analyzer::gui
+
+#endif
@@ -1,14 +1,21 @@
 #include "main_window.h"
 #include "application.h"
+#include "frame_loader.h"
+#include "frame_view.h"
 #include "qtag.h"
+#include "timeline_chart.h"
+#include "training_panel.h"
 #include "ui_main_window.h"
 #include <QComboBox>
 #include <QDir>
+#include <QDockWidget>
 #include <QFileDialog>
 #include <QLabel>
 #include <QMenu>
-#include <QPainter>
 #include <QToolButton>
+#include <QVBoxLayout>
+#include <stdexcept>
+#include <utility>
 
 namespace analyzer::gui
 {
@@ -26,8 +33,7 @@ namespace analyzer::gui
 
     void clear_display(const Ui::main_window& display)
     {
-      display.frame_display->setPixmap(QPixmap {});
-      display.frame_display->setText("No Sequence Loaded");
+      display.frame_display->clear();
       display.frame_spinbox->setValue(0);
       display.frame_slider->setValue(0);
     }
@@ -50,26 +56,27 @@ namespace analyzer::gui
     }
 
     auto get_tracking_paths_to_draw(
-      [[maybe_unused]] const Ui::main_window& main_window,
-      const QComboBox& sequence_combobox,
-      [[maybe_unused]] const QList<QAction*>& tracker_actions)
+      const std::vector<QPolygonF>& tracking_paths,
+      const QList<QAction*>& tracker_actions)
     {
+      // The paths are cached, and QPolygonF shares its data, so no path is
+      // copied or recalculated here.
       std::vector<QPolygonF> paths;
-      paths.emplace_back(get_tracking_path_to_draw(
-        application::dataset()[sequence_combobox.currentIndex()]
-          .target_boxes()));
-      std::vector<color_map::size_type> color_indices(1, 0);
+      std::vector<color_map::size_type> color_indices;
+      if (tracking_paths.empty())
+      {
+        return std::make_pair(paths, color_indices);
+      }
+      paths.push_back(tracking_paths.front());
+      color_indices.push_back(0);
       color_map::size_type current_index {0};
       for (const auto* action : tracker_actions)
       {
         ++current_index;
-        if (action->isChecked())
+        if (action->isChecked() && current_index < tracking_paths.size()
+            && !tracking_paths[current_index].isEmpty())
         {
-          paths.emplace_back(get_tracking_path_to_draw(
-            application::tracking_results()[action->text().toStdString()]
-                                           [sequence_combobox.currentText()
-                                              .toStdString()]
-                                             .bounding_boxes()));
+          paths.push_back(tracking_paths[current_index]);
           color_indices.push_back(current_index);
         }
       }
@@ -78,7 +85,8 @@ namespace analyzer::gui
 
     auto get_bounding_boxes_to_draw(const Ui::main_window& main_window,
                                     const QComboBox& sequence_combobox,
-                                    const QList<QAction*>& tracker_actions)
+                                    const QList<QAction*>& tracker_actions,
+                                    const sequence_id_list& sequence_ids)
     {
       analyzer::bounding_box_list boxes;
       boxes.emplace_back(application::ground_truth_bounding_box(
@@ -87,12 +95,14 @@ namespace analyzer::gui
       color_map::size_type current_index {0};
       for (const auto* action : tracker_actions)
       {
+        const auto tracker_id {current_index};
         ++current_index;
-        if (action->isChecked())
+        if (action->isChecked() && tracker_id < sequence_ids.size()
+            && sequence_ids[tracker_id])
         {
           boxes.emplace_back(application::tracking_result_bounding_box(
-            action->text().toStdString(),
-            sequence_combobox.currentText().toStdString(),
+            tracker_id,
+            *sequence_ids[tracker_id],
             static_cast<bounding_box_list::size_type>(
               main_window.frame_spinbox->value())));
           color_indices.push_back(current_index);
@@ -101,67 +111,19 @@ namespace analyzer::gui
       return std::make_pair(boxes, color_indices);
     }
 
-    void
-    draw_boxes_on_image(QImage& image,
-                        const analyzer::bounding_box_list& boxes,
-                        const color_map& colors,
-                        const std::vector<color_map::size_type>& color_indices)
+    auto make_colors(const color_map& colors,
+                     const std::vector<color_map::size_type>& color_indices)
     {
-      QPainter painter {&image};
-      painter.setBrush(Qt::NoBrush);
-      QPen pen {Qt::red};
-      pen.setWidth(2);
-      for (std::array<QColor, 3>::size_type i {0};
-           i < std::min(colors.size(), boxes.size());
-           ++i)
-      {
-        pen.setColor(colors[color_indices[i]]);
-        painter.setPen(pen);
-        const auto box {boxes.at(i)};
-        painter.drawRect(QRectF {box.x, box.y, box.width, box.height});
-      }
-    }
-
-    void
-    draw_paths_on_image(QImage& image,
-                        const std::vector<QPolygonF>& paths,
-                        const color_map& colors,
-                        const std::vector<color_map::size_type>& color_indices,
-                        const int current_frame)
-    {
-      QPainter painter {&image};
-      painter.setBrush(Qt::NoBrush);
-      QPen pen {Qt::red};
-      pen.setWidth(3);
-      QVector<QPointF> current_points;
-      static constexpr int quarter_alpha {64};
-      for (std::array<QColor, 3>::size_type i {0};
-           i < std::min(colors.size(), paths.size());
-           ++i)
-      {
-        auto color {colors[color_indices[i]]};
-        pen.setColor(color);
-        painter.setPen(pen);
-        painter.drawPolyline(paths.at(i).data(), current_frame);
-        pen.setColor(
-          QColor {color.red(), color.green(), color.blue(), quarter_alpha});
-        painter.setPen(pen);
-        painter.drawPolyline(&paths.at(i)[current_frame],
-                             paths[i].size() - current_frame);
-        current_points.push_back(paths.at(i)[current_frame]);
-      }
-      // I found 12 for the pen width by trial and error.
-      // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
-      pen.setWidth(12);
-      pen.setCapStyle(Qt::RoundCap);
-      for (std::array<QColor, 3>::size_type i {0};
-           i < std::min(colors.size(), paths.size());
-           ++i)
+      std::vector<QColor> overlay_colors;
+      overlay_colors.reserve(color_indices.size());
+      for (const auto i : color_indices)
       {
-        pen.setColor(colors[color_indices[i]]);
-        painter.setPen(pen);
-        painter.drawPoint(current_points[static_cast<int>(i)]);
+        if (i < colors.size())
+        {
+          overlay_colors.push_back(colors[i]);
+        }
       }
+      return overlay_colors;
     }
 
     auto create_tag_label(main_window* parent,
@@ -250,10 +212,21 @@ namespace analyzer::gui
     ui(new Ui::main_window),
     m_dataset_info_label {new QLabel {"No dataset", this}},
     m_sequence_combobox {new QComboBox {this}},
-    m_draw_combobox {new QComboBox {this}}
+    m_draw_combobox {new QComboBox {this}},
+    m_training_dock {new QDockWidget {"Training Scores", this}},
+    m_training_panel {new training_panel {m_training_dock}},
+    m_timeline_dock {new QDockWidget {"Timelines", this}},
+    m_overlap_chart {new timeline_chart {"Overlap Ratio", 1.0, this}},
+    m_offset_chart {
+      new timeline_chart {"Center Offset (pixels)", std::nullopt, this}},
+    m_frame_cache_label {new QLabel {this}},
+    m_frame_loader {new frame_loader {
+      application::worker_count(), application::frame_cache_budget(), this}}
   {
     ui->setupUi(this);
     setup_toolbar();
+    setup_training_dock();
+    setup_timeline_dock();
     setWindowTitle("");
 
     // change_sequence() is called by Qt during initialization. Reset the
@@ -261,12 +234,22 @@ namespace analyzer::gui
     ui->frame_spinbox->setEnabled(false);
     ui->frame_slider->setEnabled(false);
 
+    ui->statusbar->addPermanentWidget(m_frame_cache_label);
     ui->statusbar->addPermanentWidget(m_dataset_info_label);
 
     connect(ui->action_quit,
             &QAction::triggered,
             application::instance(),
             &application::quit);
+    connect(m_frame_loader,
+            &frame_loader::frame_loaded,
+            this,
+            [this](const int frame_index) {
+              if (frame_index == ui->frame_spinbox->value())
+              {
+                draw_current_frame();
+              }
+            });
     restore_window(*this);
   }
 
@@ -302,6 +285,38 @@ namespace analyzer::gui
             &main_window::change_draw);
   }
 
+  void main_window::setup_training_dock()
+  {
+    // restoreState() needs the object name to find the dock.
+    m_training_dock->setObjectName("training_dock");
+    m_training_dock->setWidget(m_training_panel);
+    addDockWidget(Qt::BottomDockWidgetArea, m_training_dock);
+    m_training_dock->hide();
+    connect(m_training_panel,
+            &training_panel::frame_selected,
+            this,
+            [this](const int frame_index) {
+              if (ui->frame_spinbox->isEnabled()
+                  && m_sequence_combobox->currentText()
+                       == m_training_panel->sequence_name())
+              {
+                ui->frame_spinbox->setValue(frame_index);
+              }
+            });
+  }
+
+  void main_window::setup_timeline_dock()
+  {
+    m_timeline_dock->setObjectName("timeline_dock");
+    auto* const charts {new QWidget {m_timeline_dock}};
+    auto* const layout {new QVBoxLayout {charts}};
+    layout->addWidget(m_overlap_chart);
+    layout->addWidget(m_offset_chart);
+    m_timeline_dock->setWidget(charts);
+    addDockWidget(Qt::BottomDockWidgetArea, m_timeline_dock);
+    m_timeline_dock->hide();
+  }
+
   void main_window::open_tracking_results()
   {
     const auto results_path {QFileDialog::getExistingDirectory(
@@ -316,6 +331,42 @@ namespace analyzer::gui
     }
   }
 
+  void main_window::open_training_scores()
+  {
+    const auto scores_path {QFileDialog::getOpenFileName(
+      this,
+      "Open Training Scores",
+      application::settings()
+        .value(settings_keys::last_loaded_training_scores, QDir::homePath())
+        .toString(),
+      "JSON (*.json)")};
+    if (scores_path.isEmpty())
+    {
+      return;
+    }
+    setCursor(Qt::WaitCursor);
+    const auto cursor_reverter {
+      gsl::finally([this]() { setCursor(Qt::ArrowCursor); })};
+    try
+    {
+      m_training_panel->load(scores_path);
+    }
+    catch (const std::exception& e)
+    {
+      ui->statusbar->showMessage("Could not load " + scores_path + ": "
+                                   + e.what(),
+                                 status_bar_message_timeout.count());
+      return;
+    }
+    application::settings().setValue(
+      settings_keys::last_loaded_training_scores, scores_path);
+    m_training_dock->show();
+    if (m_sequence_combobox->isEnabled())
+    {
+      m_sequence_combobox->setCurrentText(m_training_panel->sequence_name());
+    }
+  }
+
   void main_window::open_dataset()
   {
     const auto dataset_path {QFileDialog::getExistingDirectory(
@@ -332,14 +383,38 @@ namespace analyzer::gui
 
   void main_window::change_sequence(const int index)
   {
+    if (index >= 0)
+    {
+      // Lazily loaded sequences read their data here, and may turn out to be
+      // invalid.
+      try
+      {
+        application::dataset()[index].load();
+      }
+      catch (const analyzer::invalid_sequence& e)
+      {
+        ui->statusbar->showMessage(e.what(),
+                                   status_bar_message_timeout.count());
+        m_sequence_combobox->setCurrentIndex(-1);
+        return;
+      }
+    }
+    // Switch the frame loader first; clearing the display draws frame 0.
+    m_frame_loader->set_sequence(
+      index,
+      index >= 0 ? application::dataset()[index].frames()
+                 : analyzer::frame_path_list {});
     analyzer::gui::clear_display(*ui);
+    update_sequence_ids();
+    update_tracking_paths();
+    update_timelines();
     if (index >= 0)
     {
       reset_tags(m_tag_labels, application::dataset()[index].tags());
       analyzer::gui::synchronize_frame_controls(*ui, 0);
       draw_current_frame();
       const auto maximum_frame {
-        application::dataset().sequences()[index].frame_paths().length() - 1};
+        application::dataset()[index].frame_count() - 1};
       ui->frame_spinbox->setEnabled(true);
       ui->frame_spinbox->setSuffix(" of " + QString::number(maximum_frame));
       ui->frame_spinbox->setMaximum(maximum_frame);
@@ -352,12 +427,14 @@ namespace analyzer::gui
 
   void main_window::change_draw([[maybe_unused]] const int index)
   {
-    draw_current_frame();
+    draw_overlay();
   }
 
   void main_window::change_frame(const int frame_index) const
   {
     analyzer::gui::synchronize_frame_controls(*ui, frame_index);
+    m_overlap_chart->set_cursor(frame_index);
+    m_offset_chart->set_cursor(frame_index);
     draw_current_frame();
   }
 
@@ -370,7 +447,8 @@ namespace analyzer::gui
       m_tracker_labels[gsl::narrow<std::vector<qtag*>::size_type>(i)]
         ->setVisible(tracker_actions[i]->isChecked());
     }
-    draw_current_frame();
+    update_timelines();
+    draw_overlay();
   }
 
   void main_window::load_tracking_results_directory(const QString& filepath)
@@ -378,7 +456,9 @@ namespace analyzer::gui
     setCursor(Qt::WaitCursor);
     const auto cursor_reverter {
       gsl::finally([this]() { setCursor(Qt::ArrowCursor); })};
-    application::load_tracking_results(filepath);
+    const auto errors {application::load_tracking_results(filepath)};
+    update_sequence_ids();
+    update_tracking_paths();
     auto* const tracker_menu {ui->action_tracker_selection->menu()};
     tracker_menu->clear();
     m_box_colors = make_color_map();
@@ -399,11 +479,18 @@ namespace analyzer::gui
       m_tracker_labels.push_back(tag);
     }
     ui->action_tracker_selection->setEnabled(true);
-    ui->statusbar->showMessage(
+    update_timelines();
+    m_timeline_dock->show();
+    auto message {
       "Loaded "
-        + QString::number(analyzer::size(application::tracking_results()))
-        + " trackers from " + filepath,
-      status_bar_message_timeout.count());
+      + QString::number(analyzer::size(application::tracking_results()))
+      + " trackers from " + filepath};
+    if (!errors.empty())
+    {
+      message += " (could not read " + QString::number(errors.size())
+                 + " files)";
+    }
+    ui->statusbar->showMessage(message, status_bar_message_timeout.count());
   }
 
   void main_window::load_dataset(const QString& dataset_path)
@@ -412,10 +499,12 @@ namespace analyzer::gui
     const auto cursor_reverter {
       gsl::finally([this]() { setCursor(Qt::ArrowCursor); })};
     // BUG Why am I loading the dataset twice?
-    const auto new_dataset {analyzer::load_dataset(dataset_path)};
+    const auto new_dataset {analyzer::load_dataset(
+      dataset_path, dataset_load_options {load_mode::lazy})};
     if (!new_dataset.root_path().isEmpty())
     {
-      application::load_dataset(dataset_path);
+      m_frame_loader->clear();
+      const auto skipped {application::load_dataset(dataset_path)};
       m_box_colors = make_color_map();
       ui->action_open_dataset->setEnabled(false);
       m_sequence_combobox->setEnabled(true);
@@ -427,6 +516,13 @@ namespace analyzer::gui
       ui->tracker_name_layout->addWidget(gt_tag);
       m_dataset_info_label->setToolTip(create_dataset_info());
       m_dataset_info_label->setText("OTB-100");
+      if (!skipped.empty())
+      {
+        ui->statusbar->showMessage(
+          "Skipped " + QString::number(skipped.size())
+            + " invalid sequences in " + dataset_path,
+          status_bar_message_timeout.count());
+      }
     }
   }
 
@@ -436,33 +532,148 @@ namespace analyzer::gui
     QMainWindow::closeEvent(event);
   }
 
-  void main_window::draw_current_frame() const
+  void main_window::update_sequence_ids()
   {
-    if (m_sequence_combobox->currentIndex() >= 0)
+    // Look up the current sequence in each tracker's results once, so drawing
+    // a frame doesn't have to search for them by name.
+    m_sequence_ids.clear();
+    if (m_sequence_combobox->currentIndex() < 0)
+    {
+      return;
+    }
+    const auto sequence_name {
+      m_sequence_combobox->currentText().toStdString()};
+    for (const auto& tracker : std::as_const(application::tracking_results()))
+    {
+      m_sequence_ids.push_back(tracker.find(sequence_name));
+    }
+  }
+
+  void main_window::update_tracking_paths()
+  {
+    // Calculate each path once per sequence, instead of once per frame.
+    m_tracking_paths.clear();
+    const auto sequence_index {m_sequence_combobox->currentIndex()};
+    if (sequence_index < 0)
+    {
+      return;
+    }
+    m_tracking_paths.push_back(get_tracking_path_to_draw(
+      application::dataset()[sequence_index].target_boxes()));
+    const auto& results {std::as_const(application::tracking_results())};
+    for (results_database::size_type i {0}; i < m_sequence_ids.size(); ++i)
     {
-      auto frame_image {application::frame_image(
-        m_sequence_combobox->currentIndex(), ui->frame_spinbox->value())};
-      if (m_draw_combobox->currentIndex() == 0)
+      m_tracking_paths.push_back(
+        m_sequence_ids[i]
+          ? get_tracking_path_to_draw(
+            results[i][*m_sequence_ids[i]].bounding_boxes())
+          : QPolygonF {});
+    }
+  }
+
+  void main_window::update_timelines()
+  {
+    // The metrics are cached with the results, so this only calculates them
+    // the first time a tracker is checked for a sequence.
+    std::vector<timeline> overlaps;
+    std::vector<timeline> offsets;
+    const auto sequence_index {m_sequence_combobox->currentIndex()};
+    const auto tracker_actions {
+      ui->action_tracker_selection->menu()->actions()};
+    const auto tracker_count {
+      sequence_index < 0
+        ? results_database::size_type {0}
+        : std::min(
+          m_sequence_ids.size(),
+          gsl::narrow<results_database::size_type>(tracker_actions.size()))};
+    for (results_database::size_type i {0}; i < tracker_count; ++i)
+    {
+      const auto* const action {tracker_actions[gsl::narrow<int>(i)]};
+      if (!action->isChecked() || !m_sequence_ids[i])
+      {
+        continue;
+      }
+      try
       {
-        const auto [boxes, color_indices] = get_bounding_boxes_to_draw(
-          *ui,
-          *m_sequence_combobox,
-          ui->action_tracker_selection->menu()->actions());
-        draw_boxes_on_image(frame_image, boxes, m_box_colors, color_indices);
+        const auto& metrics {application::tracking_result_metrics(
+          i, *m_sequence_ids[i], sequence_index)};
+        const auto color {m_box_colors[i + 1]};
+        overlaps.push_back(timeline {action->text(), color, metrics.overlaps});
+        offsets.push_back(timeline {action->text(), color, metrics.offsets});
       }
-      else
+      catch (const std::invalid_argument&)
       {
-        const auto [paths, color_indices] = get_tracking_paths_to_draw(
-          *ui,
-          *m_sequence_combobox,
-          ui->action_tracker_selection->menu()->actions());
-        draw_paths_on_image(frame_image,
-                            paths,
-                            m_box_colors,
-                            color_indices,
-                            ui->frame_spinbox->value());
+        // The results don't have a box for every frame, so there's nothing
+        // to compare frame by frame.
       }
-      ui->frame_display->setPixmap(QPixmap::fromImage(frame_image));
     }
+    m_overlap_chart->set_timelines(std::move(overlaps));
+    m_offset_chart->set_timelines(std::move(offsets));
+  }
+
+  void main_window::draw_current_frame() const
+  {
+    if (m_sequence_combobox->currentIndex() >= 0)
+    {
+      // If the frame isn't decoded yet, keep showing the previous frame. The
+      // frame loader signals when it's ready.
+      const auto frame {m_frame_loader->frame(ui->frame_spinbox->value())};
+      if (!frame)
+      {
+        return;
+      }
+      ui->frame_display->set_frame(*frame);
+      draw_overlay();
+      update_frame_cache_label();
+    }
+  }
+
+  void main_window::draw_overlay() const
+  {
+    if (m_sequence_combobox->currentIndex() < 0)
+    {
+      return;
+    }
+    if (m_draw_combobox->currentIndex() == 0)
+    {
+      const auto [boxes, color_indices] = get_bounding_boxes_to_draw(
+        *ui,
+        *m_sequence_combobox,
+        ui->action_tracker_selection->menu()->actions(),
+        m_sequence_ids);
+      ui->frame_display->set_boxes(boxes,
+                                   make_colors(m_box_colors, color_indices));
+    }
+    else
+    {
+      const auto [paths, color_indices] = get_tracking_paths_to_draw(
+        m_tracking_paths, ui->action_tracker_selection->menu()->actions());
+      ui->frame_display->set_paths(paths,
+                                   make_colors(m_box_colors, color_indices),
+                                   ui->frame_spinbox->value());
+    }
+  }
+
+  void main_window::update_frame_cache_label() const
+  {
+    constexpr double bytes_per_mebibyte {1024.0 * 1024.0};
+    const auto& cache {m_frame_loader->cache()};
+    const auto& statistics {cache.statistics()};
+    m_frame_cache_label->setText(
+      QString {"Frame cache: %1 hits, %2 misses, %3 evictions"}
+        .arg(statistics.hits)
+        .arg(statistics.misses)
+        .arg(statistics.evictions));
+    m_frame_cache_label->setToolTip(
+      QString {"%1 frames, %2 of %3 MiB"}
+        .arg(cache.size())
+        .arg(static_cast<double>(cache.size_bytes()) / bytes_per_mebibyte,
+             0,
+             'f',
+             1)
+        .arg(static_cast<double>(cache.byte_budget()) / bytes_per_mebibyte,
+             0,
+             'f',
+             1));
   }
 }  // namespace analyzer::gui
@@ -3,20 +3,29 @@
 
 #include "color.h"
 #include <QMainWindow>
+#include <QPolygonF>
+#include <optional>
 #include <vector>
 
 class QComboBox;
+class QDockWidget;
 class QLabel;
 
 namespace analyzer::gui
 {
+  class frame_loader;
   class qtag;
+  class timeline_chart;
+  class training_panel;
 
   namespace Ui
   {
     class main_window;
   }  // namespace Ui
 
+  /// For each tracker, the index of the current sequence in its results.
+  using sequence_id_list = std::vector<std::optional<std::size_t>>;
+
   class main_window final: public QMainWindow
   {
     // NOLINTNEXTLINE(modernize-use-trailing-return-type)
@@ -34,6 +43,7 @@ namespace analyzer::gui
   public slots:  // NOLINT(readability-redundant-access-specifiers)
     void open_dataset();
     void open_tracking_results();
+    void open_training_scores();
     void change_sequence(int index);
     void change_frame(int frame_index) const;
     void toggle_tracker(bool);
@@ -54,11 +64,37 @@ namespace analyzer::gui
     QComboBox* m_draw_combobox;
     void setup_toolbar();
 
+    // The training scores go in a dock, which stays hidden until scores are
+    // loaded.
+    QDockWidget* m_training_dock;
+    training_panel* m_training_panel;
+    void setup_training_dock();
+
+    // The overlap and center offset of each checked tracker, by frame.
+    QDockWidget* m_timeline_dock;
+    timeline_chart* m_overlap_chart;
+    timeline_chart* m_offset_chart;
+    void setup_timeline_dock();
+    void update_timelines();
+
+    QLabel* m_frame_cache_label;
+    frame_loader* m_frame_loader;
+    void update_frame_cache_label() const;
+
     void load_tracking_results_directory(const QString& filepath);
     std::vector<qtag*> m_tag_labels;
     std::vector<qtag*> m_tracker_labels;
 
+    sequence_id_list m_sequence_ids;
+    void update_sequence_ids();
+
+    // The ground truth path is first, then each tracker's path. A tracker
+    // without results for the sequence has an empty path.
+    std::vector<QPolygonF> m_tracking_paths;
+    void update_tracking_paths();
+
     void draw_current_frame() const;
+    void draw_overlay() const;
   };
 }  // namespace analyzer::gui
 
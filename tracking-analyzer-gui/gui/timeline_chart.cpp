@@ -0,0 +1,145 @@
+#include "timeline_chart.h"
+#include "tracking-analyzer/decimation.h"
+#include <QChart>
+#include <QLegend>
+#include <QLegendMarker>
+#include <QLineSeries>
+#include <QPen>
+#include <QValueAxis>
+#include <algorithm>
+#include <gsl/gsl_util>
+#include <utility>
+
+namespace analyzer::gui
+{
+  namespace
+  {
+    // LTTB needs at least this many points.
+    constexpr int minimum_point_count {3};
+
+    auto make_axis(const QString& title, const QString& label_format)
+    {
+      auto* const axis {new QtCharts::QValueAxis};
+      axis->setTitleText(title);
+      axis->setLabelFormat(label_format);
+      return axis;
+    }
+
+    auto largest_value(const std::vector<timeline>& timelines)
+    {
+      auto maximum {0.0f};
+      for (const auto& line : timelines)
+      {
+        for (const auto value : line.values)
+        {
+          maximum = std::max(maximum, value);
+        }
+      }
+      return gsl::narrow_cast<qreal>(maximum);
+    }
+
+    auto longest_timeline(const std::vector<timeline>& timelines)
+    {
+      std::size_t length {0};
+      for (const auto& line : timelines)
+      {
+        length = std::max(length, line.values.size());
+      }
+      return length;
+    }
+  }  // namespace
+
+  timeline_chart::timeline_chart(const QString& title,
+                                 const std::optional<qreal> y_maximum,
+                                 QWidget* parent):
+    QtCharts::QChartView {new QtCharts::QChart, parent},
+    m_y_maximum {y_maximum},
+    m_x_axis {make_axis("Frame", "%i")},
+    m_y_axis {make_axis(title, "%.2f")},
+    m_cursor {new QtCharts::QLineSeries}
+  {
+    auto& metric_chart {*chart()};
+    metric_chart.setTitle(title);
+    metric_chart.addAxis(m_x_axis, Qt::AlignBottom);
+    metric_chart.addAxis(m_y_axis, Qt::AlignLeft);
+    m_y_axis->setRange(0.0, m_y_maximum.value_or(1.0));
+    m_cursor->setPen(QPen {Qt::black, 1.0, Qt::DashLine});
+    metric_chart.addSeries(m_cursor);
+    m_cursor->attachAxis(m_x_axis);
+    m_cursor->attachAxis(m_y_axis);
+    for (auto* const marker : metric_chart.legend()->markers(m_cursor))
+    {
+      marker->setVisible(false);
+    }
+    metric_chart.legend()->setAlignment(Qt::AlignRight);
+  }
+
+  void timeline_chart::set_timelines(std::vector<timeline> timelines)
+  {
+    m_timelines = std::move(timelines);
+    auto& metric_chart {*chart()};
+    while (m_series.size() > m_timelines.size())
+    {
+      metric_chart.removeSeries(m_series.back());
+      delete m_series.back();  // NOLINT(cppcoreguidelines-owning-memory)
+      m_series.pop_back();
+    }
+    while (m_series.size() < m_timelines.size())
+    {
+      auto* const series {new QtCharts::QLineSeries};
+      series->setUseOpenGL(true);
+      metric_chart.addSeries(series);
+      series->attachAxis(m_x_axis);
+      series->attachAxis(m_y_axis);
+      m_series.push_back(series);
+    }
+    for (std::size_t i {0}; i < m_series.size(); ++i)
+    {
+      m_series[i]->setName(m_timelines[i].name);
+      m_series[i]->setColor(m_timelines[i].color);
+    }
+    const auto length {longest_timeline(m_timelines)};
+    const auto last_frame {length > 0 ? length - 1 : 0};
+    m_x_axis->setRange(0.0, gsl::narrow_cast<qreal>(last_frame));
+    if (!m_y_maximum)
+    {
+      m_y_axis->setRange(0.0, std::max(largest_value(m_timelines), 1.0));
+    }
+    // The cursor spans the y axis, which may have changed.
+    set_cursor(m_cursor_frame);
+    update_series();
+  }
+
+  void timeline_chart::set_cursor(const int frame_index)
+  {
+    m_cursor_frame = frame_index;
+    const auto x {gsl::narrow_cast<qreal>(frame_index)};
+    m_cursor->replace(QVector<QPointF> {{x, m_y_axis->min()},
+                                        {x, m_y_axis->max()}});
+  }
+
+  void timeline_chart::resizeEvent(QResizeEvent* event)
+  {
+    QtCharts::QChartView::resizeEvent(event);
+    if (point_count() != m_downsampled_count)
+    {
+      update_series();
+    }
+  }
+
+  auto timeline_chart::point_count() const -> int
+  {
+    // One point per pixel column is as much detail as the chart can show.
+    return std::max(width(), minimum_point_count);
+  }
+
+  void timeline_chart::update_series()
+  {
+    m_downsampled_count = point_count();
+    for (std::size_t i {0}; i < m_series.size(); ++i)
+    {
+      m_series[i]->replace(
+        downsample_lttb(m_timelines[i].values, m_downsampled_count));
+    }
+  }
+}  // namespace analyzer::gui
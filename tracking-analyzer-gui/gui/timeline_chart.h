@@ -0,0 +1,76 @@
+#ifndef ANALYZER_GUI_TIMELINE_CHART_H
+#define ANALYZER_GUI_TIMELINE_CHART_H
+
+#include <QChartView>
+#include <QColor>
+#include <QString>
+#include <optional>
+#include <vector>
+
+namespace QtCharts
+{
+  class QLineSeries;
+  class QValueAxis;
+}  // namespace QtCharts
+
+namespace analyzer::gui
+{
+  /// One tracker's value at each frame of a sequence.
+  struct timeline final
+  {
+    QString name;
+    QColor color;
+    std::vector<float> values;
+  };
+
+  /**
+   * \brief Chart a per-frame metric for several trackers, with a cursor on
+   *    the current frame.
+   * \details Each timeline is downsampled with LTTB to the chart's width in
+   * pixels, so a long sequence draws as fast as a short one. Line series are
+   * reused when the timelines change. Moving the cursor only moves the
+   * cursor line.
+   */
+  class timeline_chart final: public QtCharts::QChartView
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  public:
+    /**
+     * \brief Construct an empty chart.
+     * \param[in] title The chart title, which is also the y axis title.
+     * \param[in] y_maximum The top of the y axis. If this is std::nullopt,
+     *    the y axis fits the largest value.
+     * \param[in] parent The parent widget.
+     */
+    timeline_chart(const QString& title,
+                   std::optional<qreal> y_maximum,
+                   QWidget* parent = nullptr);
+
+    /// Replace the timelines on the chart.
+    void set_timelines(std::vector<timeline> timelines);
+
+    /// Move the cursor to a frame.
+    void set_cursor(int frame_index);
+
+  protected:
+    void resizeEvent(QResizeEvent* event) override;
+
+  private:
+    [[nodiscard]] auto point_count() const -> int;
+    void update_series();
+
+    std::optional<qreal> m_y_maximum;
+    QtCharts::QValueAxis* m_x_axis;
+    QtCharts::QValueAxis* m_y_axis;
+    QtCharts::QLineSeries* m_cursor;
+    std::vector<QtCharts::QLineSeries*> m_series;
+
+    std::vector<timeline> m_timelines;
+    int m_downsampled_count {0};
+    int m_cursor_frame {0};
+  };
+}  // namespace analyzer::gui
+
+#endif
@@ -0,0 +1,171 @@
+#include "training_chart.h"
+#include "tracking-analyzer/decimation.h"
+#include <QChart>
+#include <QLegend>
+#include <QLegendMarker>
+#include <QLineSeries>
+#include <QPen>
+#include <QScatterSeries>
+#include <QValueAxis>
+#include <algorithm>
+
+namespace analyzer::gui
+{
+  namespace
+  {
+    // Each cell of the decimation grid is this many pixels on a side. A
+    // marker covers at least this much of the chart, so points closer
+    // together than this are drawn over each other anyway.
+    constexpr int decimation_cell_size {2};
+
+    constexpr qreal default_point_size {5.0};
+
+    auto make_score_series(QtCharts::QChart& chart, const QString& name)
+    {
+      auto* const series {new QtCharts::QScatterSeries};
+      series->setName(name);
+      series->setMarkerSize(default_point_size);
+      series->setPen(QPen {});
+      series->setUseOpenGL(true);
+      chart.addSeries(series);
+      return series;
+    }
+
+    auto make_line_series(QtCharts::QChart& chart, const QString& name)
+    {
+      auto* const series {new QtCharts::QLineSeries};
+      series->setName(name);
+      chart.addSeries(series);
+      return series;
+    }
+
+    auto make_axis(const QString& title)
+    {
+      auto* const axis {new QtCharts::QValueAxis};
+      axis->setTitleText(title);
+      return axis;
+    }
+  }  // namespace
+
+  training_chart::training_chart(QWidget* parent):
+    QtCharts::QChartView {new QtCharts::QChart, parent},
+    m_scores {
+      make_score_series(*chart(), "Background Training Candidates"),
+      make_score_series(*chart(), "Background Mined"),
+      make_score_series(*chart(), "Target Training Candidates")},
+    m_boundary {make_line_series(*chart(), "Decision Boundary")},
+    m_thresholds {make_line_series(*chart(), "Cluster Thresholds"),
+                  make_line_series(*chart(), "Cluster Thresholds Hidden")},
+    m_x_axis {make_axis("Background Scores")},
+    m_y_axis {make_axis("Target Scores")}
+  {
+    auto& score_chart {*chart()};
+    score_chart.addAxis(m_x_axis, Qt::AlignBottom);
+    score_chart.addAxis(m_y_axis, Qt::AlignLeft);
+    for (auto* const series : score_chart.series())
+    {
+      series->attachAxis(m_x_axis);
+      series->attachAxis(m_y_axis);
+    }
+    // Both threshold lines use the background candidates' color, and share
+    // one legend entry.
+    for (auto* const line : m_thresholds)
+    {
+      line->setColor(m_scores[0]->color());
+    }
+    for (auto* const marker : score_chart.legend()->markers(m_thresholds[1]))
+    {
+      marker->setVisible(false);
+    }
+    score_chart.legend()->setAlignment(Qt::AlignRight);
+  }
+
+  void training_chart::set_batch(const training_batch& batch,
+                                 const QString& title)
+  {
+    m_batch = batch;
+    const auto [low, high] = get_chart_range(batch);
+    m_x_axis->setRange(low, high);
+    m_y_axis->setRange(low, high);
+    m_boundary->replace(QVector<QPointF> {{low, low}, {high, high}});
+    m_thresholds[0]->replace(
+      QVector<QPointF> {{batch.background_threshold, low},
+                        {batch.background_threshold, high}});
+    m_thresholds[1]->replace(QVector<QPointF> {
+      {low, batch.target_threshold}, {high, batch.target_threshold}});
+    chart()->setTitle(title);
+    update_scores();
+  }
+
+  void training_chart::clear()
+  {
+    m_batch.reset();
+    for (auto* const series : chart()->series())
+    {
+      dynamic_cast<QtCharts::QXYSeries*>(series)->clear();
+    }
+    chart()->setTitle("");
+  }
+
+  void training_chart::set_point_size(const qreal size)
+  {
+    for (auto* const series : m_scores)
+    {
+      series->setMarkerSize(size);
+    }
+  }
+
+  void training_chart::set_plot_visible(const training_plot plot,
+                                        const bool visible)
+  {
+    if (plot == training_plot::thresholds)
+    {
+      for (auto* const line : m_thresholds)
+      {
+        line->setVisible(visible);
+      }
+      return;
+    }
+    m_scores.at(static_cast<std::size_t>(plot))->setVisible(visible);
+  }
+
+  void training_chart::resizeEvent(QResizeEvent* event)
+  {
+    QtCharts::QChartView::resizeEvent(event);
+    if (grid_size() != m_decimated_size)
+    {
+      update_scores();
+    }
+  }
+
+  auto training_chart::grid_size() const -> QSize
+  {
+    // The view is a little larger than the plot area, so this grid is a
+    // little finer than it needs to be. The plot area isn't laid out until
+    // the chart is drawn, though, and the view's size is always current.
+    return QSize {std::max(width() / decimation_cell_size, 1),
+                  std::max(height() / decimation_cell_size, 1)};
+  }
+
+  void training_chart::update_scores()
+  {
+    if (!m_batch)
+    {
+      return;
+    }
+    m_decimated_size = grid_size();
+    const auto bounds {get_chart_range(*m_batch)};
+    const std::array<const score_list*, 3> scores {
+      &m_batch->background_candidates,
+      &m_batch->background_mined,
+      &m_batch->target_candidates};
+    for (std::size_t i {0}; i < scores.size(); ++i)
+    {
+      m_scores.at(i)->replace(decimate_to_grid(*scores.at(i),
+                                               bounds,
+                                               bounds,
+                                               m_decimated_size.width(),
+                                               m_decimated_size.height()));
+    }
+  }
+}  // namespace analyzer::gui
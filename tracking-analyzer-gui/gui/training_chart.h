@@ -0,0 +1,80 @@
+#ifndef ANALYZER_GUI_TRAINING_CHART_H
+#define ANALYZER_GUI_TRAINING_CHART_H
+
+#include "tracking-analyzer/training_metadata.h"
+#include <QChartView>
+#include <QSize>
+#include <array>
+#include <optional>
+
+namespace QtCharts
+{
+  class QLineSeries;
+  class QScatterSeries;
+  class QValueAxis;
+}  // namespace QtCharts
+
+namespace analyzer::gui
+{
+  /// The parts of a training batch that a training_chart can show or hide.
+  enum class training_plot
+  {
+    background_candidates,
+    background_mined,
+    target_candidates,
+    thresholds
+  };
+
+  /**
+   * \brief Show the scores of one training batch as a scatter chart.
+   * \details The series and axes are created once, and each new batch
+   * replaces their points. The score series render with OpenGL. Before the
+   * scores go to the chart, they're decimated to a grid the size of the
+   * chart in pixels, so a batch with hundreds of thousands of scores draws
+   * about as fast as a small one. Changing the point size or hiding a plot
+   * doesn't touch the points.
+   */
+  class training_chart final: public QtCharts::QChartView
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  public:
+    explicit training_chart(QWidget* parent = nullptr);
+
+    /**
+     * \brief Show a new batch.
+     * \param[in] batch The batch to show. The chart keeps a copy, so it can
+     *    decimate the scores again when it's resized.
+     * \param[in] title The chart title.
+     */
+    void set_batch(const training_batch& batch, const QString& title);
+
+    /// Remove the batch, and leave the chart empty.
+    void clear();
+
+    /// Change the size of the score markers, in pixels.
+    void set_point_size(qreal size);
+
+    /// Show or hide one part of the batch.
+    void set_plot_visible(training_plot plot, bool visible);
+
+  protected:
+    void resizeEvent(QResizeEvent* event) override;
+
+  private:
+    [[nodiscard]] auto grid_size() const -> QSize;
+    void update_scores();
+
+    std::array<QtCharts::QScatterSeries*, 3> m_scores;
+    QtCharts::QLineSeries* m_boundary;
+    std::array<QtCharts::QLineSeries*, 2> m_thresholds;
+    QtCharts::QValueAxis* m_x_axis;
+    QtCharts::QValueAxis* m_y_axis;
+
+    std::optional<training_batch> m_batch;
+    QSize m_decimated_size;
+  };
+}  // namespace analyzer::gui
+
+#endif
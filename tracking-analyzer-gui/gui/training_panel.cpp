@@ -0,0 +1,189 @@
+#include "training_panel.h"
+#include "training_chart.h"
+#include <QAction>
+#include <QHBoxLayout>
+#include <QMenu>
+#include <QSignalBlocker>
+#include <QSpinBox>
+#include <QToolButton>
+#include <QVBoxLayout>
+#include <gsl/gsl_util>
+#include <stdexcept>
+#include <utility>
+
+namespace analyzer::gui
+{
+  namespace
+  {
+    constexpr int default_point_size {5};
+    constexpr int maximum_point_size {20};
+
+    // Reset a 1-based spin box without emitting valueChanged(). With nothing
+    // to choose, the spin box is disabled at 0, and the next reset sets the
+    // minimum back to 1.
+    void reset_spinbox(QSpinBox& spinbox, const int maximum)
+    {
+      const QSignalBlocker blocker {spinbox};
+      spinbox.setEnabled(maximum > 0);
+      if (maximum > 0)
+      {
+        spinbox.setRange(1, maximum);
+      }
+      else
+      {
+        spinbox.setRange(0, 0);
+      }
+      spinbox.setValue(spinbox.minimum());
+      spinbox.setSuffix(" of " + QString::number(maximum));
+    }
+
+    auto make_spinbox(const QString& prefix, QWidget* parent)
+    {
+      auto* const spinbox {new QSpinBox {parent}};
+      spinbox->setPrefix(prefix);
+      spinbox->setMinimum(1);
+      spinbox->setEnabled(false);
+      return spinbox;
+    }
+
+    void add_plot_action(QMenu& menu,
+                         training_chart& chart,
+                         const QString& text,
+                         const training_plot plot,
+                         const bool checked)
+    {
+      auto* const action {menu.addAction(text)};
+      action->setCheckable(true);
+      action->setChecked(checked);
+      chart.set_plot_visible(plot, checked);
+      QObject::connect(
+        action, &QAction::toggled, &chart, [&chart, plot](const bool visible) {
+          chart.set_plot_visible(plot, visible);
+        });
+    }
+
+    auto make_plots_button(training_chart& chart, QWidget* parent)
+    {
+      auto* const menu {new QMenu {parent}};
+      add_plot_action(*menu,
+                      chart,
+                      "Background Candidates",
+                      training_plot::background_candidates,
+                      true);
+      add_plot_action(*menu,
+                      chart,
+                      "Background Mined",
+                      training_plot::background_mined,
+                      true);
+      add_plot_action(*menu,
+                      chart,
+                      "Target Candidates",
+                      training_plot::target_candidates,
+                      false);
+      add_plot_action(
+        *menu, chart, "Cluster Thresholds", training_plot::thresholds, false);
+      auto* const button {new QToolButton {parent}};
+      button->setText("Plots");
+      button->setMenu(menu);
+      button->setPopupMode(QToolButton::InstantPopup);
+      return button;
+    }
+  }  // namespace
+
+  training_panel::training_panel(QWidget* parent):
+    QWidget {parent},
+    m_update_spinbox {make_spinbox("Update ", this)},
+    m_batch_spinbox {make_spinbox("Batch ", this)},
+    m_point_size_spinbox {new QSpinBox {this}},
+    m_chart {new training_chart {this}}
+  {
+    m_point_size_spinbox->setPrefix("Point Size ");
+    m_point_size_spinbox->setRange(1, maximum_point_size);
+    m_point_size_spinbox->setValue(default_point_size);
+    m_chart->set_point_size(default_point_size);
+
+    auto* const controls {new QHBoxLayout};
+    controls->addWidget(m_update_spinbox);
+    controls->addWidget(m_batch_spinbox);
+    controls->addWidget(m_point_size_spinbox);
+    controls->addWidget(make_plots_button(*m_chart, this));
+    controls->addStretch();
+    auto* const layout {new QVBoxLayout {this}};
+    layout->addLayout(controls);
+    layout->addWidget(m_chart);
+
+    connect(m_update_spinbox,
+            qOverload<int>(&QSpinBox::valueChanged),
+            this,
+            &training_panel::change_update);
+    connect(m_batch_spinbox,
+            qOverload<int>(&QSpinBox::valueChanged),
+            this,
+            &training_panel::change_batch);
+    connect(m_point_size_spinbox,
+            qOverload<int>(&QSpinBox::valueChanged),
+            m_chart,
+            &training_chart::set_point_size);
+  }
+
+  training_panel::~training_panel() = default;
+
+  void training_panel::load(const QString& path)
+  {
+    auto scores {std::make_unique<training_score_index>(path)};
+    if (scores->update_count() == 0)
+    {
+      throw std::runtime_error {"The file has no training updates."};
+    }
+    m_scores = std::move(scores);
+    reset_spinbox(*m_update_spinbox,
+                  gsl::narrow<int>(m_scores->update_count()));
+    change_update(1);
+  }
+
+  auto training_panel::sequence_name() const -> QString
+  {
+    return m_scores ? m_scores->sequence_name() : QString {};
+  }
+
+  void training_panel::change_update(const int update_number)
+  {
+    const auto update {gsl::narrow<update_list::size_type>(update_number - 1)};
+    const auto batch_count {gsl::narrow<int>(m_scores->batch_count(update))};
+    reset_spinbox(*m_batch_spinbox, batch_count);
+    if (batch_count == 0)
+    {
+      m_chart->clear();
+      m_chart->chart()->setTitle("Update " + QString::number(update_number)
+                                 + " has no batches.");
+    }
+    else
+    {
+      change_batch(1);
+    }
+    emit frame_selected(m_scores->update_frames().at(update));
+  }
+
+  void training_panel::change_batch(const int batch_number)
+  {
+    try
+    {
+      const training_iterator position {
+        gsl::narrow<update_list::size_type>(m_update_spinbox->value() - 1),
+        gsl::narrow<training_update::size_type>(batch_number - 1)};
+      m_chart->set_batch(m_scores->batch(position),
+                         "Training Data - " + m_scores->sequence_name()
+                           + " - Update "
+                           + QString::number(m_update_spinbox->value())
+                           + " - Batch " + QString::number(batch_number));
+    }
+    catch (const std::exception& e)
+    {
+      // The index checked the file's syntax, but a batch can still hold the
+      // wrong kinds of values. A Qt slot must not throw, so this also catches
+      // a batch number that's out of range.
+      m_chart->clear();
+      m_chart->chart()->setTitle(e.what());
+    }
+  }
+}  // namespace analyzer::gui
@@ -0,0 +1,59 @@
+#ifndef ANALYZER_GUI_TRAINING_PANEL_H
+#define ANALYZER_GUI_TRAINING_PANEL_H
+
+#include "tracking-analyzer/training_metadata.h"
+#include <QWidget>
+#include <memory>
+
+class QSpinBox;
+
+namespace analyzer::gui
+{
+  class training_chart;
+
+  /**
+   * \brief Browse the training scores in a file, one batch at a time.
+   * \details The file is indexed when it's loaded, and each batch is parsed
+   * when it's selected.
+   */
+  class training_panel final: public QWidget
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  public:
+    explicit training_panel(QWidget* parent = nullptr);
+    training_panel(const training_panel&) = delete;
+    training_panel(training_panel&&) = delete;
+    auto operator=(const training_panel&) = delete;
+    auto operator=(training_panel&&) = delete;
+    ~training_panel() override;
+
+    /**
+     * \brief Load a training score file, and show its first batch.
+     * \param[in] path The path to the file.
+     * \throws std::exception If the file can't be read. The panel keeps the
+     *    scores it already had.
+     */
+    void load(const QString& path);
+
+    /// Get the name of the sequence the scores are for.
+    [[nodiscard]] auto sequence_name() const -> QString;
+
+  signals:
+    /// The user selected an update that happened at \a frame_index.
+    void frame_selected(int frame_index);
+
+  private:
+    void change_update(int update_number);
+    void change_batch(int batch_number);
+
+    std::unique_ptr<training_score_index> m_scores;
+    QSpinBox* m_update_spinbox;
+    QSpinBox* m_batch_spinbox;
+    QSpinBox* m_point_size_spinbox;
+    training_chart* m_chart;
+  };
+}  // namespace analyzer::gui
+
+#endif
@@ -1,24 +1,90 @@
 #include "tracking-analyzer/bounding_box.h"
-#include <QString>
-#include <QStringList>
+#include "tracking-analyzer/mapped_file.h"
+#include "tracking-analyzer/overlap_kernels.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <cmath>
+#include <gsl/gsl_util>
+#include <iterator>
 
 namespace analyzer
 {
   namespace
   {
-    auto make_bounding_box(const std::string& line)
+    [[nodiscard]] constexpr auto is_space(const char c) noexcept
     {
-      const auto strings {QString::fromStdString(line).split(',')};
-      if (strings.size() != 4)
+      return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    [[nodiscard]] auto skip_spaces(std::string_view text) noexcept
+    {
+      const auto n {
+        std::find_if_not(std::begin(text), std::end(text), &analyzer::is_space)
+        - std::begin(text)};
+      text.remove_prefix(gsl::narrow_cast<std::string_view::size_type>(n));
+      return text;
+    }
+
+    [[nodiscard]] auto end_of(const std::string_view text) noexcept
+    {
+      // std::from_chars() needs a [first, last) pair of pointers.
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return text.data() + text.size();
+    }
+
+    [[noreturn]] void throw_invalid_line(const std::string_view line)
+    {
+      throw analyzer::invalid_data {
+        "Found a bounding box line without 4 numbers: " + std::string {line}};
+    }
+
+    // Skip the separator between two numbers: a comma, spaces and tabs, or a
+    // comma with spaces and tabs around it. A second comma is left in place,
+    // so it fails to parse as the next number.
+    [[nodiscard]] auto skip_separator(const std::string_view line,
+                                      const std::string_view text)
+    {
+      auto remaining {analyzer::skip_spaces(text)};
+      if (!remaining.empty() && remaining.front() == ',')
+      {
+        remaining = analyzer::skip_spaces(remaining.substr(1));
+      }
+      if (remaining.size() == text.size())
+      {
+        analyzer::throw_invalid_line(line);
+      }
+      return remaining;
+    }
+
+    // Parse one line, without its line terminator, into a bounding box.
+    [[nodiscard]] auto parse_bounding_box(const std::string_view line)
+    {
+      std::array<bounding_box::value_type, 4> values {};
+      auto remaining {line};
+      for (auto& value : values)
       {
-        throw std::runtime_error {
-          "Found a bounding box line without 4 numbers."};
+        remaining = &value == values.data()
+                      ? analyzer::skip_spaces(remaining)
+                      : analyzer::skip_separator(line, remaining);
+        if (!remaining.empty() && remaining.front() == '+')
+        {
+          remaining.remove_prefix(1);
+        }
+        const auto [number_end, error] {
+          std::from_chars(remaining.data(), end_of(remaining), value)};
+        if (error != std::errc {})
+        {
+          analyzer::throw_invalid_line(line);
+        }
+        remaining.remove_prefix(gsl::narrow_cast<std::string_view::size_type>(
+          number_end - remaining.data()));
       }
-      return analyzer::bounding_box {strings[0].toFloat(),
-                                     strings[1].toFloat(),
-                                     strings[2].toFloat(),
-                                     strings[3].toFloat()};
+      if (!analyzer::skip_spaces(remaining).empty())
+      {
+        analyzer::throw_invalid_line(line);
+      }
+      return bounding_box {values[0], values[1], values[2], values[3]};
     }
 
     [[nodiscard]] auto center(const analyzer::bounding_box box)
@@ -56,17 +122,40 @@ namespace analyzer
     }
   }  // namespace
 
-  auto read_bounding_boxes(std::istream& stream) -> analyzer::bounding_box_list
+  auto parse_bounding_boxes(std::string_view text)
+    -> analyzer::bounding_box_list
   {
-    std::string line;
     analyzer::bounding_box_list boxes;
-    while (std::getline(stream, line))
+    boxes.reserve(gsl::narrow_cast<bounding_box_list::size_type>(
+                    std::count(std::begin(text), std::end(text), '\n'))
+                  + 1);
+    while (!text.empty())
     {
-      boxes.emplace_back(analyzer::make_bounding_box(line));
+      const auto line_length {std::min(text.find('\n'), text.size())};
+      const auto line {text.substr(0, line_length)};
+      if (!analyzer::skip_spaces(line).empty())
+      {
+        boxes.push_back(analyzer::parse_bounding_box(line));
+      }
+      text.remove_prefix(std::min(line_length + 1, text.size()));
     }
     return boxes;
   }
 
+  auto read_bounding_boxes(std::istream& stream) -> analyzer::bounding_box_list
+  {
+    const std::string text {std::istreambuf_iterator<char> {stream},
+                            std::istreambuf_iterator<char> {}};
+    return analyzer::parse_bounding_boxes(text);
+  }
+
+  auto read_bounding_box_file(const std::string& path)
+    -> analyzer::bounding_box_list
+  {
+    const analyzer::mapped_file file {path};
+    return analyzer::parse_bounding_boxes(file.data());
+  }
+
   auto calculate_overlap(const analyzer::bounding_box& a,
                          const analyzer::bounding_box& b) -> analyzer::overlap
   {
@@ -87,16 +176,9 @@ namespace analyzer
     {
       throw std::invalid_argument {"Bounding box lists have different sizes."};
     }
-    analyzer::overlap_list overlaps;
-    overlaps.reserve(a.size());
-    auto ai {std::begin(a)};
-    auto bi {std::begin(b)};
-    while (ai != std::end(a) && bi != std::end(b))
-    {
-      overlaps.push_back(analyzer::calculate_overlap(*ai, *bi));
-      ++ai;
-      ++bi;
-    }
+    analyzer::overlap_list overlaps(a.size());
+    analyzer::calculate_overlaps(
+      a, b, overlaps, analyzer::best_instruction_set());
     return overlaps;
   }
 
@@ -2,6 +2,8 @@
 #define ANALYZER_BOUNDING_BOX_H
 
 #include <istream>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace analyzer
@@ -30,9 +32,36 @@ namespace analyzer
   using offset = float;
   using offset_list = std::vector<analyzer::offset>;
 
+  /**
+   * \brief Parse bounding boxes from text.
+   * \param[in] text The text to parse. Each line is one box: x, y, width, and
+   *    height. The numbers are separated by one comma, by spaces or tabs, or
+   *    by one comma with spaces or tabs around it. Blank lines are skipped.
+   * \return The bounding boxes, in the order they appear in \a text.
+   * \throws invalid_data If a line does not have exactly four numbers. A
+   *    repeated comma, such as "1,,2,3,4", is an empty number.
+   * \details The parser works in place on \a text; it does not allocate
+   * memory for each line.
+   */
+  [[nodiscard]] auto parse_bounding_boxes(std::string_view text)
+    -> analyzer::bounding_box_list;
+
   [[nodiscard]] auto read_bounding_boxes(std::istream& stream)
     -> analyzer::bounding_box_list;
 
+  /**
+   * \brief Read bounding boxes from a file.
+   * \param[in] path The path to the file. The file format is described by
+   *    parse_bounding_boxes().
+   * \return The bounding boxes in the file.
+   * \throws std::runtime_error If the file cannot be opened.
+   * \throws invalid_data If a line does not have exactly four numbers.
+   * \details This memory maps the file and parses it in place, so it's the
+   * fastest way to load ground truth and tracking results.
+   */
+  [[nodiscard]] auto read_bounding_box_file(const std::string& path)
+    -> analyzer::bounding_box_list;
+
   [[nodiscard]] auto calculate_overlap(const analyzer::bounding_box& a,
                                        const analyzer::bounding_box& b)
     -> analyzer::overlap;
@@ -0,0 +1,128 @@
+#include "tracking-analyzer/box_array.h"
+#include "tracking-analyzer/overlap_kernels.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace analyzer
+{
+  namespace
+  {
+    void check_sizes(const box_array& a, const box_array& b)
+    {
+      if (a.size() != b.size())
+      {
+        throw std::invalid_argument {"Box arrays have different sizes: "
+                                     + std::to_string(a.size()) + " and "
+                                     + std::to_string(b.size())};
+      }
+    }
+  }  // namespace
+
+  box_array::box_array(const bounding_box_list& boxes)
+  {
+    reserve(boxes.size());
+    for (const auto& box : boxes)
+    {
+      push_back(box);
+    }
+  }
+
+  auto box_array::size() const noexcept -> size_type
+  {
+    return m_x.size();
+  }
+
+  auto box_array::empty() const noexcept -> bool
+  {
+    return m_x.empty();
+  }
+
+  void box_array::reserve(const size_type n)
+  {
+    m_x.reserve(n);
+    m_y.reserve(n);
+    m_width.reserve(n);
+    m_height.reserve(n);
+  }
+
+  void box_array::push_back(const bounding_box& box)
+  {
+    m_x.push_back(box.x);
+    m_y.push_back(box.y);
+    m_width.push_back(box.width);
+    m_height.push_back(box.height);
+  }
+
+  auto box_array::operator[](const size_type i) const -> bounding_box
+  {
+    return bounding_box {m_x.at(i), m_y.at(i), m_width.at(i), m_height.at(i)};
+  }
+
+  auto box_array::x() const noexcept -> gsl::span<const value_type>
+  {
+    return m_x;
+  }
+
+  auto box_array::y() const noexcept -> gsl::span<const value_type>
+  {
+    return m_y;
+  }
+
+  auto box_array::width() const noexcept -> gsl::span<const value_type>
+  {
+    return m_width;
+  }
+
+  auto box_array::height() const noexcept -> gsl::span<const value_type>
+  {
+    return m_height;
+  }
+
+  auto to_bounding_box_list(const box_array& boxes) -> bounding_box_list
+  {
+    bounding_box_list list;
+    list.reserve(boxes.size());
+    for (box_array::size_type i {0}; i < boxes.size(); ++i)
+    {
+      list.push_back(boxes[i]);
+    }
+    return list;
+  }
+
+  auto calculate_overlaps(const box_array& a, const box_array& b)
+    -> overlap_list
+  {
+    check_sizes(a, b);
+    overlap_list overlaps(a.size());
+    analyzer::calculate_overlaps(
+      a, b, overlaps, analyzer::best_instruction_set());
+    return overlaps;
+  }
+
+  auto calculate_offsets(const box_array& a, const box_array& b)
+    -> offset_list
+  {
+    check_sizes(a, b);
+    // This is the same arithmetic as calculate_offset(), written over the
+    // coordinate arrays so the compiler can vectorize the loop.
+    constexpr box_array::value_type half {0.5f};
+    constexpr box_array::value_type square {2.0f};
+    const auto ax {a.x()};
+    const auto ay {a.y()};
+    const auto aw {a.width()};
+    const auto ah {a.height()};
+    const auto bx {b.x()};
+    const auto by {b.y()};
+    const auto bw {b.width()};
+    const auto bh {b.height()};
+    offset_list offsets(a.size());
+    for (box_array::size_type i {0}; i < a.size(); ++i)
+    {
+      const auto dx {(ax[i] + half * aw[i]) - (bx[i] + half * bw[i])};
+      const auto dy {(ay[i] + half * ah[i]) - (by[i] + half * bh[i])};
+      offsets[i] = std::sqrt(std::pow(dx, square) + std::pow(dy, square));
+    }
+    return offsets;
+  }
+}  // namespace analyzer
@@ -0,0 +1,169 @@
+#ifndef ANALYZER_BOX_ARRAY_H
+#define ANALYZER_BOX_ARRAY_H
+
+#include "tracking-analyzer/bounding_box.h"
+#include <cstddef>
+#include <gsl/span>
+#include <new>
+#include <vector>
+
+namespace analyzer
+{
+  /**
+   * \brief Allocate memory aligned to a specific boundary.
+   * \tparam T The type of object to allocate.
+   * \tparam Alignment The alignment, in bytes, of each allocation.
+   */
+  template <typename T, std::size_t Alignment>
+  struct aligned_allocator
+  {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+      using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() noexcept = default;
+
+    template <typename U>
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    aligned_allocator(
+      const aligned_allocator<U, Alignment>& /*unused*/) noexcept
+    {
+    }
+
+    [[nodiscard]] auto allocate(const std::size_t n) -> T*
+    {
+      return static_cast<T*>(
+        ::operator new(n * sizeof(T), std::align_val_t {Alignment}));
+    }
+
+    void deallocate(T* const p, const std::size_t /*unused*/) noexcept
+    {
+      ::operator delete(p, std::align_val_t {Alignment});
+    }
+  };
+
+  template <typename T, typename U, std::size_t Alignment>
+  [[nodiscard]] constexpr auto
+  operator==(const aligned_allocator<T, Alignment>& /*unused*/,
+             const aligned_allocator<U, Alignment>& /*unused*/) noexcept
+  {
+    return true;
+  }
+
+  template <typename T, typename U, std::size_t Alignment>
+  [[nodiscard]] constexpr auto
+  operator!=(const aligned_allocator<T, Alignment>& /*unused*/,
+             const aligned_allocator<U, Alignment>& /*unused*/) noexcept
+  {
+    return false;
+  }
+
+  /**
+   * \brief Store bounding boxes as a structure of arrays.
+   * \details A bounding_box_list stores each box's x, y, width, and height
+   * next to each other. A box_array stores all the x coordinates in one
+   * contiguous array, all the y coordinates in another, and so on. Each array
+   * starts on a 64-byte boundary. This layout suits metric kernels that
+   * process many boxes with vector instructions, or that only read some of
+   * the coordinates, such as the centers for the center offset.
+   *
+   * Use box_array(const bounding_box_list&) and to_bounding_box_list() to
+   * convert between the two layouts.
+   */
+  class box_array final
+  {
+  public:
+    using value_type = bounding_box::value_type;
+    using size_type = std::size_t;
+
+    /// The alignment, in bytes, of each coordinate array.
+    static constexpr std::size_t alignment {64};
+
+    /// The storage for one coordinate of every box.
+    using column
+      = std::vector<value_type, aligned_allocator<value_type, alignment>>;
+
+    /// Construct an empty box array.
+    box_array() = default;
+
+    /**
+     * \brief Construct a box array from a list of boxes.
+     * \param[in] boxes The boxes to copy into the box array.
+     */
+    explicit box_array(const bounding_box_list& boxes);
+
+    /// Get the number of boxes.
+    [[nodiscard]] auto size() const noexcept -> size_type;
+
+    /// Check whether the box array has no boxes.
+    [[nodiscard]] auto empty() const noexcept -> bool;
+
+    /// Reserve space for \a n boxes.
+    void reserve(size_type n);
+
+    /// Append a box to the end of the box array.
+    void push_back(const bounding_box& box);
+
+    /**
+     * \brief Get a copy of one box.
+     * \param[in] i The 0-based index of the box.
+     * \return The box at index \a i.
+     * \throws std::out_of_range If \f$i \ge size()\f$.
+     */
+    [[nodiscard]] auto operator[](size_type i) const -> bounding_box;
+
+    /// Get the x coordinates of all the boxes.
+    [[nodiscard]] auto x() const noexcept -> gsl::span<const value_type>;
+
+    /// Get the y coordinates of all the boxes.
+    [[nodiscard]] auto y() const noexcept -> gsl::span<const value_type>;
+
+    /// Get the widths of all the boxes.
+    [[nodiscard]] auto width() const noexcept -> gsl::span<const value_type>;
+
+    /// Get the heights of all the boxes.
+    [[nodiscard]] auto height() const noexcept -> gsl::span<const value_type>;
+
+  private:
+    column m_x;
+    column m_y;
+    column m_width;
+    column m_height;
+  };
+
+  /**
+   * \brief Convert a box array to a list of boxes.
+   * \param[in] boxes The boxes to convert.
+   * \return The same boxes, in the same order, as a bounding_box_list.
+   * \related box_array
+   */
+  [[nodiscard]] auto to_bounding_box_list(const box_array& boxes)
+    -> bounding_box_list;
+
+  /**
+   * \brief Calculate the overlap of each pair of boxes in two box arrays.
+   * \throws std::invalid_argument If \a a and \a b are different sizes.
+   * \details The results are the same as for
+   * calculate_overlaps(const bounding_box_list&, const bounding_box_list&).
+   * \related box_array
+   */
+  [[nodiscard]] auto calculate_overlaps(const box_array& a, const box_array& b)
+    -> overlap_list;
+
+  /**
+   * \brief Calculate the center offset of each pair of boxes in two box
+   *    arrays.
+   * \throws std::invalid_argument If \a a and \a b are different sizes.
+   * \details The results are the same as for
+   * calculate_offsets(const bounding_box_list&, const bounding_box_list&).
+   * \related box_array
+   */
+  [[nodiscard]] auto calculate_offsets(const box_array& a, const box_array& b)
+    -> offset_list;
+}  // namespace analyzer
+
+#endif
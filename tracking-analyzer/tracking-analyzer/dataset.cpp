@@ -1,9 +1,14 @@
 #include "tracking-analyzer/dataset.h"
+#include "tracking-analyzer/dataset_index.h"
 #include "tracking-analyzer/filesystem.h"
+#include "tracking-analyzer/parallel.h"
 #include <QDir>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <gsl/gsl_assert>
+#include <iterator>
+#include <vector>
 
 namespace analyzer
 {
@@ -15,21 +20,50 @@ namespace analyzer
       return directory.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
     }
 
-    auto read_sequences(const QString& dataset_path)
+    struct sequence_task final
+    {
+      analyzer::sequence sequence;
+      std::string error;
+    };
+
+    // Each sequence gets its own slot, so the sequences stay in name order no
+    // matter which thread reads them.
+    auto read_sequences(const QString& dataset_path,
+                        const analyzer::dataset_load_options& options,
+                        analyzer::load_error_list& skipped)
     {
       const auto names {read_sequence_names(dataset_path)};
+      std::vector<sequence_task> tasks(
+        gsl::narrow_cast<std::vector<sequence_task>::size_type>(names.size()));
+      analyzer::parallel_for(
+        tasks.size(),
+        options.worker_count,
+        [&tasks, &names, &dataset_path, &options](const std::size_t i) {
+          const auto& name {names[gsl::narrow_cast<int>(i)]};
+          try
+          {
+            tasks[i].sequence = analyzer::sequence {
+              name, dataset_path + '/' + name, options.mode};
+          }
+          catch (const std::exception& e)
+          {
+            tasks[i].error = e.what();
+          }
+        });
       QVector<analyzer::sequence> sequences;
       sequences.reserve(names.size());
-      for (const auto& name : names)
+      for (std::vector<sequence_task>::size_type i {0}; i < tasks.size(); ++i)
       {
-        try
+        if (tasks[i].error.empty())
         {
-          sequences.push_back(
-            analyzer::sequence {name, dataset_path + '/' + name});
+          sequences.push_back(std::move(tasks[i].sequence));
         }
-        catch (...)
+        else
         {
-          // Do nothing for now. Maybe try to report it in the future.
+          skipped.push_back(analyzer::load_error {
+            (dataset_path + '/' + names[gsl::narrow_cast<int>(i)])
+              .toStdString(),
+            std::move(tasks[i].error)});
         }
       }
       return sequences;
@@ -40,21 +74,21 @@ namespace analyzer
       QDir directory {sequence_path};
       if (!directory.cd("img"))
       {
-        return QStringList {};
+        return analyzer::frame_path_list {};
       }
-      auto frame_paths {
+      return analyzer::frame_path_list {
+        directory.absolutePath(),
         directory.entryList({"*.jpg"}, QDir::Files, QDir::Name)};
-      for (auto& frame_path : frame_paths)
-      {
-        frame_path.prepend('/').prepend(directory.absolutePath());
-      }
-      return frame_paths;
     }
 
     auto read_ground_truth_boxes(const std::string& path)
     {
-      std::ifstream s {path + "/groundtruth_rect.txt"};
-      return analyzer::read_bounding_boxes(s);
+      const auto file_path {path + "/groundtruth_rect.txt"};
+      if (!std::filesystem::exists(file_path))
+      {
+        return analyzer::bounding_box_list {};
+      }
+      return analyzer::read_bounding_box_file(file_path);
     }
 
     auto abbreviation_to_tag(const std::string& abbreviation)
@@ -132,12 +166,24 @@ namespace analyzer
     }
   }  // namespace
 
+  auto stamp_sequence(const QString& path) -> sequence_stamps
+  {
+    const auto root {path.toStdString()};
+    return {stamp_file(root),
+            stamp_file(root + "/img"),
+            stamp_file(root + "/groundtruth_rect.txt"),
+            stamp_file(root + "/attrs.txt")};
+  }
+
   sequence::sequence(const QString& name, const QString& path):
-    m_name {name},
-    m_root_path {path},
-    m_frame_paths {analyzer::make_sequence_frame_paths(path)},
-    m_target_boxes {analyzer::read_ground_truth_boxes(path.toStdString())},
-    m_tags {analyzer::read_sequence_tags(path.toStdString())}
+    sequence {name, path, analyzer::load_mode::eager}
+  {
+  }
+
+  sequence::sequence(const QString& name,
+                     const QString& path,
+                     const analyzer::load_mode mode):
+    m_name {name}, m_root_path {path}
   {
     if (m_root_path.isEmpty())
     {
@@ -146,39 +192,114 @@ namespace analyzer
         m_root_path.toStdString(),
         "A sequence cannot have an empty root path."};
     }
-    if (!QDir {m_root_path}.exists())
-    {
-      throw analyzer::invalid_sequence {
-        m_name.toStdString(),
-        m_root_path.toStdString(),
-        "The sequence path " + m_root_path.toStdString() + " does not exist."};
-    }
-    if (m_frame_paths.isEmpty())
+    if (mode == analyzer::load_mode::eager)
     {
-      throw analyzer::invalid_sequence {
-        m_name.toStdString(),
-        m_root_path.toStdString(),
-        "The sequence " + m_name.toStdString() + " at path "
-          + m_root_path.toStdString() + " does not have frame images."};
+      load();
     }
   }
 
+  sequence::sequence(const QString& name,
+                     const QString& path,
+                     analyzer::frame_path_list frames,
+                     analyzer::box_array target_boxes,
+                     QStringList tags,
+                     const sequence_stamps& stamps):
+    sequence {name, path, analyzer::load_mode::lazy}
+  {
+    sequence_data data {
+      std::move(frames), std::move(target_boxes), std::move(tags), stamps};
+    static_cast<void>(
+      m_data->get([&data]() -> sequence_data { return std::move(data); }));
+  }
+
   auto sequence::name() const -> QString { return m_name; }
-  auto sequence::frame_paths() const -> QStringList { return m_frame_paths; }
+  auto sequence::frame_paths() const -> QStringList
+  {
+    return data().frame_paths.to_string_list();
+  }
+  auto sequence::frames() const -> const analyzer::frame_path_list&
+  {
+    return data().frame_paths;
+  }
+  auto sequence::frame_count() const -> int
+  {
+    return data().frame_paths.size();
+  }
   auto sequence::path() const -> QString { return m_root_path; }
   auto sequence::target_boxes() const -> analyzer::bounding_box_list
   {
-    return m_target_boxes;
+    return analyzer::to_bounding_box_list(data().target_boxes);
+  }
+  auto sequence::target_box_array() const -> const analyzer::box_array&
+  {
+    return data().target_boxes;
+  }
+  auto sequence::tags() const -> QStringList { return data().tags; }
+  auto sequence::stamps() const -> const sequence_stamps&
+  {
+    return data().stamps;
   }
-  auto sequence::tags() const -> QStringList { return m_tags; }
 
   auto sequence::operator[](gsl::index index) const -> analyzer::frame
   {
+    const auto& d {data()};
     Expects(index >= 0
-            && index < gsl::narrow_cast<gsl::index>(m_target_boxes.size()));
+            && index < gsl::narrow_cast<gsl::index>(d.target_boxes.size()));
     return analyzer::frame {
-      m_frame_paths[gsl::narrow_cast<int>(index)].toStdString(),
-      m_target_boxes[gsl::narrow_cast<sequence::size_type>(index)]};
+      d.frame_paths[gsl::narrow_cast<int>(index)].toStdString(),
+      d.target_boxes[gsl::narrow_cast<sequence::size_type>(index)]};
+  }
+
+  void sequence::load() const { static_cast<void>(data()); }
+
+  auto sequence::is_loaded() const noexcept -> bool
+  {
+    return m_root_path.isEmpty() || m_data->has_value();
+  }
+
+  auto sequence::data() const -> const sequence_data&
+  {
+    // A default constructed sequence has no directory to read.
+    if (m_root_path.isEmpty())
+    {
+      static const sequence_data empty_data;
+      return empty_data;
+    }
+    return m_data->get([this]() {
+      if (!QDir {m_root_path}.exists())
+      {
+        throw analyzer::invalid_sequence {
+          m_name.toStdString(),
+          m_root_path.toStdString(),
+          "The sequence path " + m_root_path.toStdString()
+            + " does not exist."};
+      }
+      // Stamp the files before reading them. If one changes during the read,
+      // the stamp is stale, not the data.
+      sequence_data new_data;
+      new_data.stamps = stamp_sequence(m_root_path);
+      // The three reads are independent, and each blocks on the file
+      // system, so overlap them.
+      const auto path {m_root_path.toStdString()};
+      auto boxes {std::async(std::launch::async, [&path]() {
+        return analyzer::read_ground_truth_boxes(path);
+      })};
+      auto tags {std::async(std::launch::async, [&path]() {
+        return analyzer::read_sequence_tags(path);
+      })};
+      new_data.frame_paths = analyzer::make_sequence_frame_paths(m_root_path);
+      new_data.target_boxes = boxes.get();
+      new_data.tags = tags.get();
+      if (new_data.frame_paths.empty())
+      {
+        throw analyzer::invalid_sequence {
+          m_name.toStdString(),
+          m_root_path.toStdString(),
+          "The sequence " + m_name.toStdString() + " at path "
+            + m_root_path.toStdString() + " does not have frame images."};
+      }
+      return new_data;
+    });
   }
 
   dataset::dataset(const QString& root_path,
@@ -222,10 +343,61 @@ namespace analyzer
   }
 
   auto load_dataset(const QString& path) -> analyzer::dataset
+  {
+    return analyzer::load_dataset(path, dataset_load_options {});
+  }
+
+  auto load_dataset(const QString& path, const dataset_load_options& options)
+    -> analyzer::dataset
+  {
+    load_error_list skipped;
+    return analyzer::load_dataset(path, options, skipped);
+  }
+
+  auto load_dataset(const QString& path,
+                    const dataset_load_options& options,
+                    load_error_list& skipped) -> analyzer::dataset
+  {
+    std::optional<load_error> index_error;
+    return analyzer::load_dataset(path, options, skipped, index_error);
+  }
+
+  auto load_dataset(const QString& path,
+                    const dataset_load_options& options,
+                    load_error_list& skipped,
+                    std::optional<load_error>& index_error) -> analyzer::dataset
   {
     const auto dataset_path {analyzer::make_absolute_path(path)};
-    return analyzer::dataset {dataset_path,
-                              analyzer::read_sequences(dataset_path)};
+    const auto use_index {!options.index_path.isEmpty()};
+    if (use_index && !options.rebuild_index)
+    {
+      if (auto indexed {analyzer::read_dataset_index(
+            options.index_path, dataset_path, skipped)})
+      {
+        return std::move(*indexed);
+      }
+    }
+    load_error_list new_skipped;
+    analyzer::dataset new_dataset {
+      dataset_path,
+      analyzer::read_sequences(dataset_path, options, new_skipped)};
+    // A lazy dataset hasn't read its sequences, so it can't be indexed yet.
+    if (use_index && options.mode == analyzer::load_mode::eager)
+    {
+      try
+      {
+        analyzer::write_dataset_index(
+          options.index_path, new_dataset, new_skipped);
+      }
+      catch (const std::runtime_error& e)
+      {
+        index_error = load_error {options.index_path.toStdString(), e.what()};
+      }
+    }
+    skipped.insert(std::end(skipped),
+                   std::make_move_iterator(std::begin(new_skipped)),
+                   std::make_move_iterator(std::end(new_skipped)));
+    return new_dataset;
   }
 
   auto sequence_names(const QVector<analyzer::sequence>& sequences)
@@ -2,10 +2,17 @@
 #define TRACKING_ANALYZER_DATASET_H
 
 #include "tracking-analyzer/bounding_box.h"
+#include "tracking-analyzer/box_array.h"
 #include "tracking-analyzer/exceptions.h"
+#include "tracking-analyzer/frame_path_list.h"
+#include "tracking-analyzer/lazy.h"
+#include "tracking-analyzer/results_cache.h"
 #include <QStringList>
 #include <QVector>
+#include <array>
 #include <gsl/gsl_util>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 
 namespace analyzer
@@ -16,25 +23,109 @@ namespace analyzer
     analyzer::bounding_box ground_truth_bounding_box;
   };
 
+  /// Choose when a sequence reads its frame list, ground truth, and tags.
+  enum class load_mode
+  {
+    eager,  ///< Read everything when the sequence is constructed.
+    lazy    ///< Read everything the first time any of it is needed.
+  };
+
+  /// The stamps of a sequence directory, its image directory, its ground
+  /// truth file, and its attributes file, in that order.
+  using sequence_stamps = std::array<file_stamp, 4>;
+
+  /// Stamp the files of the sequence at \a path.
+  [[nodiscard]] auto stamp_sequence(const QString& path) -> sequence_stamps;
+
+  /**
+   * \brief A sequence of frames, and the ground truth for each frame.
+   * \details A lazily loaded sequence reads its data the first time an
+   * accessor other than name() or path() is called. That first access may
+   * throw analyzer::invalid_sequence, for the same reasons the eager
+   * constructor does; the next access tries again. Loading is thread-safe, and
+   * copies of a sequence share the loaded data, no matter which copy loaded it.
+   */
   class sequence final
   {
   public:
     using size_type = analyzer::bounding_box_list::size_type;
     sequence() = default;
     sequence(const QString& name, const QString& path);
+
+    /**
+     * \brief Construct a sequence, choosing when to read its data.
+     * \param[in] name The name of the sequence.
+     * \param[in] path The path to the sequence directory.
+     * \param[in] mode When to read the frame list, ground truth, and tags.
+     * \throws analyzer::invalid_sequence If \a path is empty. For eager
+     *    loading, also if \a path doesn't exist or has no frame images.
+     */
+    sequence(const QString& name, const QString& path, load_mode mode);
+
+    /**
+     * \brief Construct a sequence from data that's already been read, for
+     *    example from a dataset index.
+     * \param[in] name The name of the sequence.
+     * \param[in] path The path to the sequence directory.
+     * \param[in] frames The paths to the frame images.
+     * \param[in] target_boxes The ground truth box for each frame.
+     * \param[in] tags The sequence's attribute tags.
+     * \param[in] stamps The stamps of the sequence's files when the data was
+     *    read.
+     */
+    sequence(const QString& name,
+             const QString& path,
+             analyzer::frame_path_list frames,
+             analyzer::box_array target_boxes,
+             QStringList tags,
+             const sequence_stamps& stamps);
+
     [[nodiscard]] auto name() const -> QString;
+
+    /// Build the path to every frame image. Use frames() or frame_count()
+    /// unless you need a QStringList.
     [[nodiscard]] auto frame_paths() const -> QStringList;
+
+    /// Get the paths to the frame images, without building them all.
+    [[nodiscard]] auto frames() const -> const analyzer::frame_path_list&;
+
+    /// Get the number of frames in the sequence.
+    [[nodiscard]] auto frame_count() const -> int;
+
     [[nodiscard]] auto path() const -> QString;
     [[nodiscard]] auto target_boxes() const -> analyzer::bounding_box_list;
+    [[nodiscard]] auto target_box_array() const -> const analyzer::box_array&;
     [[nodiscard]] auto tags() const -> QStringList;
+
+    /**
+     * \brief Get the stamps of the sequence's files.
+     * \details The files are stamped just before they're read, so the stamps
+     * match the data. If a file changes while it's read, its stamp is out of
+     * date, and a dataset index sees that the sequence must be read again.
+     */
+    [[nodiscard]] auto stamps() const -> const sequence_stamps&;
     [[nodiscard]] auto operator[](gsl::index index) const -> analyzer::frame;
 
+    /// Read the sequence data now, if it hasn't been read yet.
+    void load() const;
+
+    /// Check whether the sequence data has been read.
+    [[nodiscard]] auto is_loaded() const noexcept -> bool;
+
   private:
+    struct sequence_data final
+    {
+      analyzer::frame_path_list frame_paths;
+      analyzer::box_array target_boxes;
+      QStringList tags;
+      sequence_stamps stamps {};
+    };
+    [[nodiscard]] auto data() const -> const sequence_data&;
+
     QString m_name;
     QString m_root_path;
-    QStringList m_frame_paths;
-    analyzer::bounding_box_list m_target_boxes;
-    QStringList m_tags;
+    std::shared_ptr<const analyzer::lazy<sequence_data>> m_data {
+      std::make_shared<const analyzer::lazy<sequence_data>>()};
   };
 
   class dataset final
@@ -55,7 +146,70 @@ namespace analyzer
     QVector<analyzer::sequence> m_sequences;
   };
 
+  /// Options that control how load_dataset() reads a dataset.
+  struct dataset_load_options final
+  {
+    /**
+     * \brief When each sequence reads its data.
+     * \details Lazy loading only lists the sequence directories, which makes
+     * opening a large dataset fast. Sequences that eager loading would skip,
+     * because they have no frames, are kept; they throw when they're used.
+     */
+    analyzer::load_mode mode {analyzer::load_mode::eager};
+
+    /// The number of threads that construct sequences. Zero means use
+    /// default_worker_count().
+    unsigned int worker_count {0};
+
+    /**
+     * \brief The path to the dataset index file. Empty means don't use an
+     *    index.
+     * \details If the index is up to date, the dataset is read from it
+     * instead of the dataset directory. Otherwise, eager loading rewrites it.
+     * \see write_dataset_index()
+     */
+    QString index_path;
+
+    /// Ignore the index, even if it's up to date, and rewrite it.
+    bool rebuild_index {false};
+  };
+
   auto load_dataset(const QString& path) -> dataset;
+  auto load_dataset(const QString& path, const dataset_load_options& options)
+    -> dataset;
+
+  /**
+   * \brief Load a dataset, and report the sequences that were skipped.
+   * \param[in] path The path to the dataset directory.
+   * \param[in] options Options that control how the dataset is read.
+   * \param[out] skipped Each sequence directory that is not a valid sequence
+   *    is appended to this list, in name order.
+   * \return The valid sequences in \a path, sorted by name.
+   * \details Sequences are constructed on a pool of threads. Within each
+   * sequence, the frame list, ground truth, and tags are read concurrently.
+   *
+   * The index only speeds up the next load, so a failure to write it is
+   * ignored. Use the overload with \a index_error to report it.
+   */
+  auto load_dataset(const QString& path,
+                    const dataset_load_options& options,
+                    load_error_list& skipped) -> dataset;
+
+  /**
+   * \brief Load a dataset, and report the sequences that were skipped and
+   *    whether the index could be written.
+   * \param[in] path The path to the dataset directory.
+   * \param[in] options Options that control how the dataset is read.
+   * \param[out] skipped Each sequence directory that is not a valid sequence
+   *    is appended to this list, in name order.
+   * \param[out] index_error Set to the index path and the reason, if the
+   *    index was rewritten and the write failed. Otherwise, it's left alone.
+   * \return The valid sequences in \a path, sorted by name.
+   */
+  auto load_dataset(const QString& path,
+                    const dataset_load_options& options,
+                    load_error_list& skipped,
+                    std::optional<load_error>& index_error) -> dataset;
 
   auto sequence_names(const QVector<analyzer::sequence>& sequences)
     -> QStringList;
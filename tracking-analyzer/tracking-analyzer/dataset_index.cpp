@@ -0,0 +1,252 @@
+#include "tracking-analyzer/dataset_index.h"
+#include "tracking-analyzer/results_cache.h"
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <array>
+#include <gsl/gsl_util>
+#include <iterator>
+
+namespace analyzer
+{
+  namespace
+  {
+    constexpr char magic[] {"TAINDEX"};  // NOLINT
+
+    // Pin the stream format, so a newer Qt writes the same file.
+    constexpr auto stream_version {QDataStream::Qt_5_9};
+
+    [[nodiscard]] auto stamp(const QString& path)
+    {
+      return analyzer::stamp_file(path.toStdString());
+    }
+
+    auto operator<<(QDataStream& stream, const file_stamp& s) -> QDataStream&
+    {
+      return stream << qint64 {s.size} << qint64 {s.modified};
+    }
+
+    auto operator>>(QDataStream& stream, file_stamp& s) -> QDataStream&
+    {
+      qint64 size {0};
+      qint64 modified {0};
+      stream >> size >> modified;
+      s = file_stamp {size, modified};
+      return stream;
+    }
+
+    auto operator<<(QDataStream& stream, const sequence_stamps& stamps)
+      -> QDataStream&
+    {
+      for (const auto& s : stamps)
+      {
+        stream << s;
+      }
+      return stream;
+    }
+
+    auto operator>>(QDataStream& stream, sequence_stamps& stamps)
+      -> QDataStream&
+    {
+      for (auto& s : stamps)
+      {
+        stream >> s;
+      }
+      return stream;
+    }
+
+    void write_frames(QDataStream& stream, const frame_path_list& frames)
+    {
+      stream << frames.directory() << qint32 {frames.size()};
+      const auto pattern {frames.pattern()};
+      stream << pattern.has_value();
+      if (pattern)
+      {
+        stream << pattern->prefix << pattern->suffix
+               << qint32 {pattern->first_number} << qint32 {pattern->width};
+      }
+      else
+      {
+        stream << frames.file_names();
+      }
+    }
+
+    [[nodiscard]] auto read_frames(QDataStream& stream)
+    {
+      QString directory;
+      qint32 count {0};
+      bool numbered {false};
+      stream >> directory >> count >> numbered;
+      if (numbered)
+      {
+        frame_name_pattern pattern;
+        qint32 first_number {0};
+        qint32 width {0};
+        stream >> pattern.prefix >> pattern.suffix >> first_number >> width;
+        pattern.first_number = first_number;
+        pattern.width = width;
+        return frame_path_list {directory, pattern, std::max(count, 0)};
+      }
+      QStringList file_names;
+      stream >> file_names;
+      return frame_path_list {directory, file_names};
+    }
+
+    void write_boxes(QDataStream& stream, const box_array& boxes)
+    {
+      stream << quint64 {boxes.size()};
+      for (box_array::size_type i {0}; i < boxes.size(); ++i)
+      {
+        const auto box {boxes[i]};
+        stream << box.x << box.y << box.width << box.height;
+      }
+    }
+
+    [[nodiscard]] auto read_boxes(QDataStream& stream, const qint64 file_size)
+    {
+      quint64 count {0};
+      stream >> count;
+      // Don't trust a corrupt count with a huge allocation.
+      constexpr quint64 box_bytes {4 * sizeof(float)};
+      if (count > gsl::narrow_cast<quint64>(file_size) / box_bytes)
+      {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return box_array {};
+      }
+      bounding_box_list boxes(count);
+      for (auto& box : boxes)
+      {
+        stream >> box.x >> box.y >> box.width >> box.height;
+      }
+      return box_array {boxes};
+    }
+  }  // namespace
+
+  void write_dataset_index(const QString& index_path,
+                           const analyzer::dataset& data,
+                           const load_error_list& skipped)
+  {
+    QByteArray buffer;
+    QDataStream stream {&buffer, QIODevice::WriteOnly};
+    stream.setVersion(stream_version);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream << QByteArray {magic} << quint32 {dataset_index_version}
+           << data.root_path() << stamp(data.root_path())
+           << quint32 {gsl::narrow<quint32>(data.sequences().size()
+                                             + skipped.size())};
+    for (const auto& s : data.sequences())
+    {
+      // A loaded sequence has the stamps from just before it was read. One
+      // that failed to load is read again by load(), so stamp it first. If a
+      // file changes while it's read, the next load sees a new stamp and
+      // reads the sequence again.
+      const auto failed_stamps {s.is_loaded() ? sequence_stamps {}
+                                              : stamp_sequence(s.path())};
+      try
+      {
+        s.load();
+      }
+      catch (const invalid_sequence& e)
+      {
+        stream << s.name() << failed_stamps << false << QString {e.what()};
+        continue;
+      }
+      stream << s.name() << s.stamps() << true;
+      write_frames(stream, s.frames());
+      write_boxes(stream, s.target_box_array());
+      stream << s.tags();
+    }
+    for (const auto& error : skipped)
+    {
+      const auto path {QString::fromStdString(error.path)};
+      stream << QFileInfo {path}.fileName() << stamp_sequence(path) << false
+             << QString::fromStdString(error.message);
+    }
+
+    QDir {}.mkpath(QFileInfo {index_path}.absolutePath());
+    QSaveFile file {index_path};
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(buffer) != buffer.size() || !file.commit())
+    {
+      throw std::runtime_error {"Cannot write the dataset index "
+                                + index_path.toStdString() + ": "
+                                + file.errorString().toStdString()};
+    }
+  }
+
+  auto read_dataset_index(const QString& index_path,
+                          const QString& dataset_path,
+                          load_error_list& skipped)
+    -> std::optional<analyzer::dataset>
+  {
+    QFile file {index_path};
+    if (!file.open(QIODevice::ReadOnly))
+    {
+      return std::nullopt;
+    }
+    QDataStream stream {&file};
+    stream.setVersion(stream_version);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    QByteArray file_magic;
+    quint32 version {0};
+    QString root_path;
+    file_stamp root_stamp;
+    quint32 count {0};
+    stream >> file_magic >> version;
+    if (file_magic != magic || version != dataset_index_version)
+    {
+      return std::nullopt;
+    }
+    stream >> root_path >> root_stamp >> count;
+    if (stream.status() != QDataStream::Ok || root_path != dataset_path
+        || root_stamp != stamp(dataset_path))
+    {
+      return std::nullopt;
+    }
+
+    QVector<sequence> sequences;
+    load_error_list index_skipped;
+    for (quint32 i {0}; i < count; ++i)
+    {
+      QString name;
+      sequence_stamps stamps;
+      bool valid {false};
+      stream >> name >> stamps >> valid;
+      const auto sequence_path {dataset_path + '/' + name};
+      if (stream.status() != QDataStream::Ok || name.isEmpty()
+          || stamps != stamp_sequence(sequence_path))
+      {
+        return std::nullopt;
+      }
+      if (!valid)
+      {
+        QString message;
+        stream >> message;
+        index_skipped.push_back(
+          load_error {sequence_path.toStdString(), message.toStdString()});
+        continue;
+      }
+      auto frames {read_frames(stream)};
+      auto boxes {read_boxes(stream, file.size())};
+      QStringList tags;
+      stream >> tags;
+      if (stream.status() != QDataStream::Ok)
+      {
+        return std::nullopt;
+      }
+      sequences.push_back(sequence {name,
+                                    sequence_path,
+                                    std::move(frames),
+                                    std::move(boxes),
+                                    std::move(tags),
+                                    stamps});
+    }
+    skipped.insert(std::end(skipped),
+                   std::make_move_iterator(std::begin(index_skipped)),
+                   std::make_move_iterator(std::end(index_skipped)));
+    return analyzer::dataset {dataset_path, sequences};
+  }
+}  // namespace analyzer
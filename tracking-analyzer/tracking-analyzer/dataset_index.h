@@ -0,0 +1,53 @@
+#ifndef ANALYZER_DATASET_INDEX_H
+#define ANALYZER_DATASET_INDEX_H
+
+#include "tracking-analyzer/dataset.h"
+#include "tracking-analyzer/exceptions.h"
+#include <QString>
+#include <cstdint>
+#include <optional>
+
+namespace analyzer
+{
+  /// The version of the dataset index file format. Index files with a
+  /// different version are ignored.
+  constexpr std::uint32_t dataset_index_version {1};
+
+  /**
+   * \brief Write a dataset index file.
+   * \param[in] index_path The path to the index file to write. If the file
+   *    exists, it's replaced atomically.
+   * \param[in] data The dataset to index. Sequences that haven't been loaded
+   *    yet are loaded first. If one is invalid, it's indexed as skipped.
+   * \param[in] skipped The sequences that were skipped when \a data was
+   *    loaded, so reading the index reports them too.
+   * \throws std::runtime_error If the index file cannot be written.
+   * \details The index has the name, frame file names, ground truth boxes,
+   * and tags of every sequence. Frame file names are stored as a pattern when
+   * they're numbered. The index also records the size and modification time of
+   * the dataset directory, and of each sequence's directory, image directory,
+   * ground truth file, and attributes file. Adding or removing a sequence or a
+   * frame, or editing a ground truth or attributes file, changes one of them.
+   */
+  void write_dataset_index(const QString& index_path,
+                           const analyzer::dataset& data,
+                           const load_error_list& skipped);
+
+  /**
+   * \brief Read a dataset from its index file.
+   * \param[in] index_path The path to the index file.
+   * \param[in] dataset_path The path to the dataset directory. It must match
+   *    the path the index was written for.
+   * \param[out] skipped The sequences that were skipped when the index was
+   *    written are appended to this list, if the index is used.
+   * \return The dataset, with every sequence loaded. If the index doesn't
+   *    exist, is corrupt, was written for another version of the format, or
+   *    is out of date, std::nullopt.
+   */
+  [[nodiscard]] auto read_dataset_index(const QString& index_path,
+                                        const QString& dataset_path,
+                                        load_error_list& skipped)
+    -> std::optional<analyzer::dataset>;
+}  // namespace analyzer
+
+#endif
@@ -0,0 +1,151 @@
+#include "tracking-analyzer/decimation.h"
+#include <algorithm>
+#include <cmath>
+#include <gsl/gsl_util>
+#include <stdexcept>
+#include <vector>
+
+namespace analyzer
+{
+  namespace
+  {
+    // Get the number of cells per unit along one axis of the grid. All the
+    // values in an empty range go in the first cell.
+    [[nodiscard]] auto cells_per_unit(const range& values, const int cells)
+    {
+      const auto width {values.second - values.first};
+      return width > 0.0f ? gsl::narrow_cast<float>(cells) / width : 0.0f;
+    }
+
+    // Get the cell that holds a value. The end of the range goes in the last
+    // cell, instead of one past it.
+    [[nodiscard]] auto cell_index(const float value,
+                                  const range& values,
+                                  const float scale,
+                                  const int cells)
+    {
+      return std::min(gsl::narrow_cast<int>((value - values.first) * scale),
+                      cells - 1);
+    }
+
+    // Get the index of the first value in a bucket. Bucket 0 is the first
+    // value alone, the last bucket is the last value alone, and the buckets
+    // in between share the rest of the values.
+    [[nodiscard]] auto bucket_start(const std::size_t bucket,
+                                    const std::size_t buckets,
+                                    const std::size_t count)
+    {
+      return bucket == 0 ? std::size_t {0}
+                         : (bucket - 1) * (count - 2) / (buckets - 2) + 1;
+    }
+
+    [[nodiscard]] auto make_point(const gsl::span<const float> values,
+                                  const std::size_t i)
+    {
+      return QPointF {gsl::narrow_cast<qreal>(i), values[i]};
+    }
+
+    // NaN compares false to everything, so it's outside every range.
+    [[nodiscard]] auto in_range(const float value, const range& values)
+    {
+      return value >= values.first && value <= values.second;
+    }
+  }  // namespace
+
+  auto decimate_to_grid(const score_list& scores,
+                        const range& x_range,
+                        const range& y_range,
+                        const int columns,
+                        const int rows) -> QVector<QPointF>
+  {
+    if (columns < 1 || rows < 1)
+    {
+      throw std::invalid_argument {
+        "A decimation grid needs at least one column and one row."};
+    }
+    const auto x {scores.x()};
+    const auto y {scores.y()};
+    const auto x_scale {cells_per_unit(x_range, columns)};
+    const auto y_scale {cells_per_unit(y_range, rows)};
+    std::vector<bool> occupied(gsl::narrow_cast<std::size_t>(columns)
+                               * gsl::narrow_cast<std::size_t>(rows));
+    QVector<QPointF> points;
+    for (score_list::size_type i {0}; i < scores.size(); ++i)
+    {
+      if (!in_range(x[i], x_range) || !in_range(y[i], y_range))
+      {
+        continue;
+      }
+      const auto cell {
+        gsl::narrow_cast<std::size_t>(
+          cell_index(y[i], y_range, y_scale, rows))
+          * gsl::narrow_cast<std::size_t>(columns)
+        + gsl::narrow_cast<std::size_t>(
+          cell_index(x[i], x_range, x_scale, columns))};
+      if (!occupied[cell])
+      {
+        occupied[cell] = true;
+        points.append(QPointF {x[i], y[i]});
+      }
+    }
+    return points;
+  }
+
+  auto downsample_lttb(const gsl::span<const float> values,
+                       const int threshold) -> QVector<QPointF>
+  {
+    if (threshold < 3)
+    {
+      throw std::invalid_argument {
+        "LTTB downsampling needs to keep at least 3 points."};
+    }
+    const auto count {values.size()};
+    QVector<QPointF> points;
+    if (count <= gsl::narrow_cast<std::size_t>(threshold))
+    {
+      points.reserve(gsl::narrow_cast<int>(count));
+      for (std::size_t i {0}; i < count; ++i)
+      {
+        points.append(make_point(values, i));
+      }
+      return points;
+    }
+    points.reserve(threshold);
+    const auto buckets {gsl::narrow_cast<std::size_t>(threshold)};
+    auto previous {make_point(values, 0)};
+    points.append(previous);
+    for (std::size_t bucket {1}; bucket + 1 < buckets; ++bucket)
+    {
+      const auto next_first {bucket_start(bucket + 1, buckets, count)};
+      const auto next_last {bucket + 2 < buckets
+                              ? bucket_start(bucket + 2, buckets, count)
+                              : count};
+      QPointF average {0.0, 0.0};
+      for (auto i {next_first}; i < next_last; ++i)
+      {
+        average += make_point(values, i);
+      }
+      average /= gsl::narrow_cast<qreal>(next_last - next_first);
+
+      auto selected {bucket_start(bucket, buckets, count)};
+      auto largest_area {-1.0};
+      for (auto i {selected}; i < next_first; ++i)
+      {
+        // Twice the area of the triangle; only the comparison matters.
+        const auto point {make_point(values, i)};
+        const auto area {std::abs(
+          (previous.x() - average.x()) * (point.y() - previous.y())
+          - (previous.x() - point.x()) * (average.y() - previous.y()))};
+        if (area > largest_area)
+        {
+          largest_area = area;
+          selected = i;
+        }
+      }
+      previous = make_point(values, selected);
+      points.append(previous);
+    }
+    points.append(make_point(values, count - 1));
+    return points;
+  }
+}  // namespace analyzer
@@ -0,0 +1,52 @@
+#ifndef ANALYZER_DECIMATION_H
+#define ANALYZER_DECIMATION_H
+
+#include "tracking-analyzer/training_metadata.h"
+#include <QPointF>
+#include <QVector>
+#include <gsl/span>
+
+namespace analyzer
+{
+  /**
+   * \brief Reduce a list of scores to at most one score per cell of a grid.
+   * \param[in] scores The scores to reduce.
+   * \param[in] x_range The range of x values the grid covers.
+   * \param[in] y_range The range of y values the grid covers.
+   * \param[in] columns The number of cells across \a x_range.
+   * \param[in] rows The number of cells across \a y_range.
+   * \return The first score that lands in each occupied cell, in their
+   *    original order. Scores outside the grid are dropped.
+   * \throws std::invalid_argument If \a columns or \a rows is less than 1.
+   * \details Size the grid to the pixels of a chart's plot area. Scores that
+   * share a cell would be drawn on top of each other anyway, so the chart
+   * looks the same, but it draws at most \a columns times \a rows points no
+   * matter how many scores there are.
+   */
+  [[nodiscard]] auto decimate_to_grid(const score_list& scores,
+                                      const range& x_range,
+                                      const range& y_range,
+                                      int columns,
+                                      int rows) -> QVector<QPointF>;
+
+  /**
+   * \brief Reduce a timeline with Largest-Triangle-Three-Buckets
+   *    downsampling.
+   * \param[in] values The value at each frame. The x coordinate of a value is
+   *    its index.
+   * \param[in] threshold The number of points to keep.
+   * \return The first and last values, plus one value from each of
+   *    \a threshold - 2 buckets in between. If \a values already has
+   *    \a threshold values or fewer, they're all returned.
+   * \throws std::invalid_argument If \a threshold is less than 3.
+   * \details From each bucket, this keeps the value that makes the largest
+   * triangle with the value kept from the previous bucket and the average of
+   * the next bucket. That keeps the peaks and dips that a line chart needs to
+   * look like the whole timeline. Use the chart's width in pixels for
+   * \a threshold.
+   */
+  [[nodiscard]] auto downsample_lttb(gsl::span<const float> values,
+                                     int threshold) -> QVector<QPointF>;
+}  // namespace analyzer
+
+#endif
@@ -0,0 +1,292 @@
+#include "tracking-analyzer/evaluation.h"
+#include "tracking-analyzer/dataset.h"
+#include "tracking-analyzer/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <gsl/gsl_assert>
+#include <gsl/gsl_util>
+#include <gsl/span>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace analyzer
+{
+  namespace
+  {
+    // Count the success thresholds that an overlap is greater than. The
+    // division gives the answer up to rounding, and the comparisons correct
+    // it, so the count matches comparing against every threshold.
+    [[nodiscard]] auto success_bin(const overlap o) noexcept
+    {
+      if (!(o > 0.0f))
+      {
+        return std::size_t {0};
+      }
+      const auto value {static_cast<double>(o)};
+      auto i {static_cast<std::size_t>(
+        std::min(value / success_threshold(1),
+                 static_cast<double>(success_threshold_count)))};
+      while (i < success_threshold_count && success_threshold(i) < value)
+      {
+        ++i;
+      }
+      while (i > 0 && success_threshold(i - 1) >= value)
+      {
+        --i;
+      }
+      return i;
+    }
+
+    // Get the index of the first precision threshold that an offset is less
+    // than or equal to. The thresholds are whole numbers of pixels, so this
+    // is the offset rounded up. Offsets that fail every threshold go in the
+    // bin past the last threshold.
+    [[nodiscard]] auto precision_bin(const offset e) noexcept
+    {
+      if (std::isnan(e))
+      {
+        return precision_threshold_count;
+      }
+      return static_cast<std::size_t>(
+        std::clamp(std::ceil(static_cast<double>(e)),
+                   0.0,
+                   static_cast<double>(precision_threshold_count)));
+    }
+
+    // Accumulate curves to calculate their mean.
+    struct curve_sum final
+    {
+      performance_curves sum;
+      std::size_t count {0};
+    };
+
+    void add(curve_sum& total, const performance_curves& curves)
+    {
+      std::transform(std::begin(total.sum.success),
+                     std::end(total.sum.success),
+                     std::begin(curves.success),
+                     std::begin(total.sum.success),
+                     std::plus<> {});
+      std::transform(std::begin(total.sum.precision),
+                     std::end(total.sum.precision),
+                     std::begin(curves.precision),
+                     std::begin(total.sum.precision),
+                     std::plus<> {});
+      ++total.count;
+    }
+
+    [[nodiscard]] auto mean(curve_sum total)
+    {
+      if (total.count > 0)
+      {
+        const auto count {static_cast<double>(total.count)};
+        const auto divide {[count](const double rate) { return rate / count; }};
+        std::transform(std::begin(total.sum.success),
+                       std::end(total.sum.success),
+                       std::begin(total.sum.success),
+                       divide);
+        std::transform(std::begin(total.sum.precision),
+                       std::end(total.sum.precision),
+                       std::begin(total.sum.precision),
+                       divide);
+      }
+      return total.sum;
+    }
+
+    [[nodiscard]] auto
+    summarize(const tracker_results& tracker,
+              const std::vector<evaluation_sequence>& sequences,
+              const gsl::span<const std::optional<performance_curves>> curves)
+    {
+      tracker_evaluation evaluation {tracker.name(), {}, {}, {}};
+      curve_sum overall;
+      std::map<std::string, curve_sum> tags;
+      for (std::size_t i {0}; i < sequences.size(); ++i)
+      {
+        const auto& sequence_curves {curves[i]};
+        if (!sequence_curves)
+        {
+          continue;
+        }
+        evaluation.sequences.push_back(
+          sequence_evaluation {sequences[i].name, *sequence_curves});
+        add(overall, *sequence_curves);
+        for (const auto& tag : sequences[i].tags)
+        {
+          add(tags[tag], *sequence_curves);
+        }
+      }
+      evaluation.overall = mean(overall);
+      for (const auto& [tag, total] : tags)
+      {
+        evaluation.tags.emplace(tag, mean(total));
+      }
+      return evaluation;
+    }
+
+    // Evaluate every tracker. A tracker and sequence pair with mismatched box
+    // counts is appended to skipped and left out of the evaluation.
+    [[nodiscard]] auto
+    evaluate_trackers(const results_database& results,
+                      const std::vector<evaluation_sequence>& sequences,
+                      const unsigned int worker_count,
+                      load_error_list& skipped)
+    {
+      const auto& trackers {results.trackers()};
+      // Each tracker and sequence pair gets a slot, so the workers don't have
+      // to coordinate. An empty slot means the tracker has no results for the
+      // sequence, or they were skipped.
+      std::vector<std::optional<performance_curves>> curves(
+        trackers.size() * sequences.size());
+      std::vector<std::optional<std::string>> errors(curves.size());
+      parallel_for(
+        curves.size(), worker_count, [&](const std::size_t i) {
+          const auto& tracker {trackers[i / sequences.size()]};
+          const auto& sequence {sequences[i % sequences.size()]};
+          Expects(sequence.ground_truth != nullptr);
+          if (const auto id {tracker.find(sequence.name)}; id)
+          {
+            try
+            {
+              curves[i] = calculate_curves(
+                tracker[*id].metrics(*sequence.ground_truth));
+            }
+            catch (const std::invalid_argument& e)
+            {
+              errors[i] = e.what();
+            }
+          }
+        });
+
+      for (std::size_t i {0}; i < errors.size(); ++i)
+      {
+        if (errors[i])
+        {
+          skipped.push_back(
+            load_error {trackers[i / sequences.size()].name() + '/'
+                          + sequences[i % sequences.size()].name,
+                        *errors[i]});
+        }
+      }
+
+      std::vector<tracker_evaluation> evaluations;
+      evaluations.reserve(trackers.size());
+      const gsl::span<const std::optional<performance_curves>> all_curves {
+        curves};
+      for (std::size_t i {0}; i < trackers.size(); ++i)
+      {
+        evaluations.push_back(summarize(
+          trackers[i],
+          sequences,
+          all_curves.subspan(i * sequences.size(), sequences.size())));
+      }
+      return evaluations;
+    }
+
+    [[nodiscard]] auto make_evaluation_sequences(const dataset& data)
+    {
+      std::vector<evaluation_sequence> sequences;
+      sequences.reserve(
+        gsl::narrow_cast<std::size_t>(data.sequences().size()));
+      for (const auto& sequence : data.sequences())
+      {
+        evaluation_sequence entry {
+          sequence.name().toStdString(), &sequence.target_box_array(), {}};
+        for (const auto& tag : sequence.tags())
+        {
+          entry.tags.push_back(tag.toStdString());
+        }
+        sequences.push_back(std::move(entry));
+      }
+      return sequences;
+    }
+  }  // namespace
+
+  auto calculate_curves(const frame_metrics& metrics) -> performance_curves
+  {
+    std::array<std::size_t, success_threshold_count + 1> success_histogram {};
+    for (const auto o : metrics.overlaps)
+    {
+      ++success_histogram.at(success_bin(o));
+    }
+    std::array<std::size_t, precision_threshold_count + 1>
+      precision_histogram {};
+    for (const auto e : metrics.offsets)
+    {
+      ++precision_histogram.at(precision_bin(e));
+    }
+
+    // A frame in success bin b succeeds at thresholds [0, b), and a frame in
+    // precision bin b is precise at thresholds [b, precision_threshold_count).
+    performance_curves curves;
+    if (!metrics.overlaps.empty())
+    {
+      const auto frame_count {static_cast<double>(metrics.overlaps.size())};
+      std::size_t passed {0};
+      for (auto i {success_threshold_count}; i > 0; --i)
+      {
+        passed += success_histogram.at(i);
+        curves.success.at(i - 1) = static_cast<double>(passed) / frame_count;
+      }
+    }
+    if (!metrics.offsets.empty())
+    {
+      const auto frame_count {static_cast<double>(metrics.offsets.size())};
+      std::size_t passed {0};
+      for (std::size_t i {0}; i < precision_threshold_count; ++i)
+      {
+        passed += precision_histogram.at(i);
+        curves.precision.at(i) = static_cast<double>(passed) / frame_count;
+      }
+    }
+    return curves;
+  }
+
+  auto area_under_curve(const success_curve& curve) noexcept -> double
+  {
+    return std::accumulate(std::begin(curve), std::end(curve), 0.0)
+           / static_cast<double>(curve.size());
+  }
+
+  auto precision_score(const precision_curve& curve) noexcept -> double
+  {
+    return std::get<precision_score_threshold>(curve);
+  }
+
+  auto evaluate(const results_database& results,
+                const std::vector<evaluation_sequence>& sequences,
+                const unsigned int worker_count)
+    -> std::vector<tracker_evaluation>
+  {
+    load_error_list skipped;
+    return evaluate_trackers(results, sequences, worker_count, skipped);
+  }
+
+  auto evaluate(const results_database& results,
+                const dataset& data,
+                const unsigned int worker_count)
+    -> std::vector<tracker_evaluation>
+  {
+    return evaluate(results, make_evaluation_sequences(data), worker_count);
+  }
+
+  auto evaluate(const results_database& results,
+                const std::vector<evaluation_sequence>& sequences,
+                const unsigned int worker_count,
+                load_error_list& skipped) -> std::vector<tracker_evaluation>
+  {
+    return evaluate_trackers(results, sequences, worker_count, skipped);
+  }
+
+  auto evaluate(const results_database& results,
+                const dataset& data,
+                const unsigned int worker_count,
+                load_error_list& skipped) -> std::vector<tracker_evaluation>
+  {
+    return evaluate(
+      results, make_evaluation_sequences(data), worker_count, skipped);
+  }
+}  // namespace analyzer
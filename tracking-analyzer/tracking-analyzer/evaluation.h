@@ -0,0 +1,225 @@
+#ifndef ANALYZER_EVALUATION_H
+#define ANALYZER_EVALUATION_H
+
+#include "tracking-analyzer/box_array.h"
+#include "tracking-analyzer/exceptions.h"
+#include "tracking-analyzer/tracking_results.h"
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace analyzer
+{
+  class dataset;
+
+  /// The number of overlap thresholds in a success curve: 0, 0.05, ..., 1.
+  constexpr std::size_t success_threshold_count {21};
+
+  /// The number of center offset thresholds in a precision curve: 0, 1, ...,
+  /// 50 pixels.
+  constexpr std::size_t precision_threshold_count {51};
+
+  /// The center offset threshold, in pixels, used for the precision score.
+  constexpr std::size_t precision_score_threshold {20};
+
+  /**
+   * \brief The fraction of frames with an overlap above each threshold.
+   * \details Element \a i is the rate for the threshold
+   * success_threshold(i).
+   */
+  using success_curve = std::array<double, success_threshold_count>;
+
+  /**
+   * \brief The fraction of frames with a center offset at or below each
+   *    threshold.
+   * \details Element \a i is the rate for the threshold
+   * precision_threshold(i).
+   */
+  using precision_curve = std::array<double, precision_threshold_count>;
+
+  /**
+   * \brief Get an overlap threshold of the success curve.
+   * \param[in] i The index of the threshold, in [0, success_threshold_count).
+   * \return The overlap threshold.
+   */
+  [[nodiscard]] constexpr auto success_threshold(const std::size_t i) noexcept
+  {
+    constexpr double step {0.05};
+    return static_cast<double>(i) * step;
+  }
+
+  /**
+   * \brief Get a center offset threshold of the precision curve.
+   * \param[in] i The index of the threshold, in [0,
+   *    precision_threshold_count).
+   * \return The center offset threshold, in pixels.
+   */
+  [[nodiscard]] constexpr auto precision_threshold(const std::size_t i) noexcept
+  {
+    return static_cast<double>(i);
+  }
+
+  /// The success and precision curves for a tracker.
+  struct performance_curves final
+  {
+    success_curve success {};
+    precision_curve precision {};
+  };
+
+  /**
+   * \brief Calculate the success and precision curves for one sequence.
+   * \param[in] metrics The per-frame overlaps and offsets of the sequence.
+   * \return The curves. If the sequence has no frames, every rate is 0.
+   * \details These are the one-pass evaluation curves from the OTB benchmark.
+   * A frame succeeds at an overlap threshold if its overlap is greater than
+   * the threshold. A frame is precise at an offset threshold if its offset is
+   * less than or equal to the threshold. A frame with a NaN overlap or offset
+   * fails every threshold.
+   *
+   * Each frame is counted in a histogram bin for the number of thresholds it
+   * passes, and then the curves are cumulative sums of the histograms. The
+   * time is proportional to the number of frames plus the number of
+   * thresholds, instead of their product.
+   */
+  [[nodiscard]] auto calculate_curves(const frame_metrics& metrics)
+    -> performance_curves;
+
+  /**
+   * \brief Calculate the area under a success curve.
+   * \param[in] curve The success curve.
+   * \return The mean success rate over all the thresholds. This is the
+   *    success score reported by the OTB benchmark.
+   */
+  [[nodiscard]] auto area_under_curve(const success_curve& curve) noexcept
+    -> double;
+
+  /**
+   * \brief Get the precision score of a precision curve.
+   * \param[in] curve The precision curve.
+   * \return The precision rate at precision_score_threshold pixels.
+   */
+  [[nodiscard]] auto precision_score(const precision_curve& curve) noexcept
+    -> double;
+
+  /// The ground truth of one sequence to evaluate trackers against.
+  struct evaluation_sequence final
+  {
+    /// The name of the sequence. Tracking results are matched to it by name.
+    std::string name;
+
+    /// The ground truth boxes. The box array must outlive the evaluation.
+    const box_array* ground_truth {nullptr};
+
+    /// The attribute tags of the sequence, such as "occlusion".
+    std::vector<std::string> tags;
+  };
+
+  /// The curves for one tracker on one sequence.
+  struct sequence_evaluation final
+  {
+    std::string name;
+    performance_curves curves;
+  };
+
+  /// The evaluation of one tracker across a dataset.
+  struct tracker_evaluation final
+  {
+    /// The name of the tracker.
+    std::string name;
+
+    /// The curves for each sequence the tracker has results for, in dataset
+    /// order.
+    std::vector<sequence_evaluation> sequences;
+
+    /// The mean of the sequence curves.
+    performance_curves overall;
+
+    /// For each attribute tag, the mean of the curves for the sequences with
+    /// that tag.
+    std::map<std::string, performance_curves> tags;
+  };
+
+  /**
+   * \brief Evaluate every tracker in a results database.
+   * \param[in] results The tracking results to evaluate.
+   * \param[in] sequences The ground truth to evaluate the results against.
+   * \param[in] worker_count The maximum number of threads to use. Zero means
+   *    use default_worker_count().
+   * \return One evaluation for each tracker, in the same order as \a results.
+   * \details Like the OTB benchmark, the overall and per-tag curves are the
+   * means of the per-sequence curves, so every sequence has the same weight
+   * regardless of its length. A tracker without results for a sequence is
+   * evaluated on the sequences it does have. Results that don't have the same
+   * number of boxes as the ground truth are left out the same way, so one bad
+   * file doesn't stop the evaluation. Use the overload with a load_error_list
+   * to find out which results were left out.
+   *
+   * The sequences are evaluated in parallel. The per-frame overlaps and
+   * offsets come from sequence_results::metrics(), so evaluating the same
+   * results again doesn't recalculate them.
+   */
+  [[nodiscard]] auto evaluate(const results_database& results,
+                              const std::vector<evaluation_sequence>& sequences,
+                              unsigned int worker_count = 0)
+    -> std::vector<tracker_evaluation>;
+
+  /**
+   * \brief Evaluate every tracker in a results database against a dataset.
+   * \param[in] results The tracking results to evaluate.
+   * \param[in] data The dataset with the ground truth.
+   * \param[in] worker_count The maximum number of threads to use. Zero means
+   *    use default_worker_count().
+   * \return One evaluation for each tracker, in the same order as \a results.
+   * \see evaluate(const results_database&, const
+   *    std::vector<evaluation_sequence>&, unsigned int)
+   */
+  [[nodiscard]] auto evaluate(const results_database& results,
+                              const dataset& data,
+                              unsigned int worker_count = 0)
+    -> std::vector<tracker_evaluation>;
+
+  /**
+   * \brief Evaluate every tracker in a results database, and report the
+   *    results that were skipped.
+   * \param[in] results The tracking results to evaluate.
+   * \param[in] sequences The ground truth to evaluate the results against.
+   * \param[in] worker_count The maximum number of threads to use. Zero means
+   *    use default_worker_count().
+   * \param[out] skipped Each tracker and sequence pair whose results don't
+   *    have the same number of boxes as the ground truth is appended to this
+   *    list, in tracker order, then sequence order. The path of each error is
+   *    "<tracker>/<sequence>".
+   * \return One evaluation for each tracker, in the same order as \a results.
+   *    A skipped pair is left out, as if the tracker had no results for the
+   *    sequence.
+   * \see evaluate(const results_database&, const
+   *    std::vector<evaluation_sequence>&, unsigned int)
+   */
+  [[nodiscard]] auto evaluate(const results_database& results,
+                              const std::vector<evaluation_sequence>& sequences,
+                              unsigned int worker_count,
+                              load_error_list& skipped)
+    -> std::vector<tracker_evaluation>;
+
+  /**
+   * \brief Evaluate every tracker in a results database against a dataset,
+   *    and report the results that were skipped.
+   * \param[in] results The tracking results to evaluate.
+   * \param[in] data The dataset with the ground truth.
+   * \param[in] worker_count The maximum number of threads to use. Zero means
+   *    use default_worker_count().
+   * \param[out] skipped Each mismatched tracker and sequence pair is appended
+   *    to this list.
+   * \return One evaluation for each tracker, in the same order as \a results.
+   * \see evaluate(const results_database&, const
+   *    std::vector<evaluation_sequence>&, unsigned int, load_error_list&)
+   */
+  [[nodiscard]] auto evaluate(const results_database& results,
+                              const dataset& data,
+                              unsigned int worker_count,
+                              load_error_list& skipped)
+    -> std::vector<tracker_evaluation>;
+}  // namespace analyzer
+
+#endif
@@ -0,0 +1,79 @@
+#include "tracking-analyzer/evaluation_report.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace analyzer
+{
+  namespace
+  {
+    template <typename Curve>
+    auto curve_to_json(const Curve& curve)
+    {
+      QJsonArray rates;
+      for (const auto rate : curve)
+      {
+        rates.append(rate);
+      }
+      return rates;
+    }
+
+    auto scores_to_json(const performance_curves& curves)
+    {
+      return QJsonObject {
+        {"success", area_under_curve(curves.success)},
+        {"precision", precision_score(curves.precision)}};
+    }
+
+    auto tracker_to_json(const tracker_evaluation& evaluation)
+    {
+      auto tracker {scores_to_json(evaluation.overall)};
+      tracker.insert("name", QString::fromStdString(evaluation.name));
+      tracker.insert("success curve",
+                     curve_to_json(evaluation.overall.success));
+      tracker.insert("precision curve",
+                     curve_to_json(evaluation.overall.precision));
+      QJsonObject tags;
+      for (const auto& [tag, curves] : evaluation.tags)
+      {
+        tags.insert(QString::fromStdString(tag), scores_to_json(curves));
+      }
+      tracker.insert("tags", tags);
+      QJsonArray sequences;
+      for (const auto& sequence : evaluation.sequences)
+      {
+        auto scores {scores_to_json(sequence.curves)};
+        scores.insert("name", QString::fromStdString(sequence.name));
+        sequences.append(scores);
+      }
+      tracker.insert("sequences", sequences);
+      return tracker;
+    }
+
+    auto skipped_to_json(const load_error_list& errors)
+    {
+      QJsonArray skipped;
+      for (const auto& error : errors)
+      {
+        skipped.append(
+          QJsonObject {{"path", QString::fromStdString(error.path)},
+                       {"message", QString::fromStdString(error.message)}});
+      }
+      return skipped;
+    }
+  }  // namespace
+
+  auto
+  make_evaluation_report(const std::vector<tracker_evaluation>& evaluations,
+                         const load_error_list& skipped) -> QByteArray
+  {
+    QJsonArray trackers;
+    for (const auto& evaluation : evaluations)
+    {
+      trackers.append(tracker_to_json(evaluation));
+    }
+    const QJsonObject report {{"trackers", trackers},
+                              {"skipped", skipped_to_json(skipped)}};
+    return QJsonDocument {report}.toJson(QJsonDocument::Indented);
+  }
+}  // namespace analyzer
@@ -0,0 +1,30 @@
+#ifndef ANALYZER_EVALUATION_REPORT_H
+#define ANALYZER_EVALUATION_REPORT_H
+
+#include "tracking-analyzer/evaluation.h"
+#include "tracking-analyzer/exceptions.h"
+#include <QByteArray>
+#include <vector>
+
+namespace analyzer
+{
+  /**
+   * \brief Write tracker evaluations as a JSON report.
+   * \param[in] evaluations The evaluations to report.
+   * \param[in] skipped The files that were skipped while loading the dataset
+   *    and the tracking results, and the results that couldn't be evaluated.
+   * \return The UTF-8 encoded JSON report.
+   * \details The report is an object with two members. "trackers" is an
+   * array with one object for each evaluation, in order. Each has the
+   * tracker's "name", its overall "success" and "precision" scores, the
+   * overall "success curve" and "precision curve", a "tags" object with the
+   * scores for each attribute tag, and a "sequences" array with the scores
+   * for each sequence. "skipped" is an array of objects with the "path" and
+   * "message" of each skipped file.
+   */
+  [[nodiscard]] auto
+  make_evaluation_report(const std::vector<tracker_evaluation>& evaluations,
+                         const load_error_list& skipped) -> QByteArray;
+}  // namespace analyzer
+
+#endif
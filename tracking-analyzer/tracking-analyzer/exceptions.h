@@ -2,6 +2,8 @@
 #define ANALYZER_EXCEPTIONS_H
 
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace analyzer
 {
@@ -34,6 +36,20 @@ namespace analyzer
   private:
     std::string m_name;
   };
+
+  /**
+   * \brief Describe one file, or directory, that a bulk load skipped.
+   * \details Loaders that read many files report problems with individual
+   * files in a list of these, instead of throwing and abandoning the whole
+   * load.
+   */
+  struct load_error final
+  {
+    std::string path;
+    std::string message;
+  };
+
+  using load_error_list = std::vector<analyzer::load_error>;
 }  // namespace analyzer
 
 #endif
@@ -0,0 +1,161 @@
+#include "tracking-analyzer/frame_path_list.h"
+#include <gsl/gsl_assert>
+#include <utility>
+
+namespace analyzer
+{
+  namespace
+  {
+    [[nodiscard]] auto is_digit(const QChar c) noexcept
+    {
+      return c >= QLatin1Char {'0'} && c <= QLatin1Char {'9'};
+    }
+
+    // Split a file name around its last run of digits.
+    [[nodiscard]] auto split_number(const QString& name)
+      -> std::optional<frame_name_pattern>
+    {
+      // More digits than this could overflow an int.
+      constexpr int maximum_width {9};
+      auto end {name.size()};
+      while (end > 0 && !is_digit(name[end - 1]))
+      {
+        --end;
+      }
+      auto begin {end};
+      while (begin > 0 && is_digit(name[begin - 1]))
+      {
+        --begin;
+      }
+      if (begin == end || end - begin > maximum_width)
+      {
+        return std::nullopt;
+      }
+      return frame_name_pattern {name.left(begin),
+                                 name.mid(end),
+                                 name.mid(begin, end - begin).toInt(),
+                                 end - begin};
+    }
+
+    [[nodiscard]] auto make_numbered_name(const frame_name_pattern& pattern,
+                                          const int index)
+    {
+      return pattern.prefix
+             + QString::number(pattern.first_number + index)
+                 .rightJustified(pattern.width, '0')
+             + pattern.suffix;
+    }
+
+    [[nodiscard]] auto is_numbered_sequence(const frame_name_pattern& pattern,
+                                            const QStringList& file_names)
+    {
+      for (int i {0}; i < file_names.size(); ++i)
+      {
+        if (file_names[i] != make_numbered_name(pattern, i))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+  }  // namespace
+
+  frame_path_list::frame_path_list(const QString& directory,
+                                   const QStringList& file_names):
+    m_directory {directory}, m_count {file_names.size()}
+  {
+    if (file_names.isEmpty())
+    {
+      return;
+    }
+    if (auto pattern {split_number(file_names.front())};
+        pattern && is_numbered_sequence(*pattern, file_names))
+    {
+      m_numbered = true;
+      m_pattern = std::move(*pattern);
+      return;
+    }
+    m_offsets.reserve(m_count + 1);
+    m_offsets.push_back(0);
+    for (const auto& name : file_names)
+    {
+      m_names.append(name.toUtf8());
+      m_offsets.push_back(m_names.size());
+    }
+  }
+
+  frame_path_list::frame_path_list(const QString& directory,
+                                   const frame_name_pattern& pattern,
+                                   const int count):
+    m_directory {directory},
+    m_count {count},
+    m_numbered {true},
+    m_pattern {pattern}
+  {
+    Expects(count >= 0);
+  }
+
+  auto frame_path_list::directory() const -> const QString&
+  {
+    return m_directory;
+  }
+
+  auto frame_path_list::size() const noexcept -> int { return m_count; }
+
+  auto frame_path_list::empty() const noexcept -> bool
+  {
+    return m_count == 0;
+  }
+
+  auto frame_path_list::is_numbered() const noexcept -> bool
+  {
+    return m_numbered;
+  }
+
+  auto frame_path_list::pattern() const -> std::optional<frame_name_pattern>
+  {
+    if (!m_numbered)
+    {
+      return std::nullopt;
+    }
+    return m_pattern;
+  }
+
+  auto frame_path_list::file_name(const int index) const -> QString
+  {
+    Expects(index >= 0 && index < m_count);
+    if (m_numbered)
+    {
+      return make_numbered_name(m_pattern, index);
+    }
+    return QString::fromUtf8(m_names.constData() + m_offsets[index],
+                             m_offsets[index + 1] - m_offsets[index]);
+  }
+
+  auto frame_path_list::operator[](const int index) const -> QString
+  {
+    return m_directory + '/' + file_name(index);
+  }
+
+  auto frame_path_list::to_string_list() const -> QStringList
+  {
+    QStringList paths;
+    paths.reserve(m_count);
+    for (int i {0}; i < m_count; ++i)
+    {
+      paths.push_back((*this)[i]);
+    }
+    return paths;
+  }
+
+  auto frame_path_list::file_names() const -> QStringList
+  {
+    QStringList names;
+    names.reserve(m_count);
+    for (int i {0}; i < m_count; ++i)
+    {
+      names.push_back(file_name(i));
+    }
+    return names;
+  }
+}  // namespace analyzer
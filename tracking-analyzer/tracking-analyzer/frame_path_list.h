@@ -0,0 +1,105 @@
+#ifndef ANALYZER_FRAME_PATH_LIST_H
+#define ANALYZER_FRAME_PATH_LIST_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <optional>
+
+namespace analyzer
+{
+  /// Describe consecutively numbered file names, such as frame_0001.jpg,
+  /// frame_0002.jpg, and so on.
+  struct frame_name_pattern final
+  {
+    QString prefix;
+    QString suffix;
+    int first_number {0};
+
+    /// The number of digits, including leading zeros.
+    int width {0};
+  };
+
+  /**
+   * \brief Store the paths to a sequence's frame images compactly.
+   * \details Every frame of a sequence is in the same directory, and most
+   * datasets number their frames consecutively with zero padding, such as
+   * 0001.jpg, 0002.jpg, and so on. For those sequences, the list stores only
+   * the directory, the file name pattern, and the number of frames. Other file
+   * names are packed, as UTF-8, into one buffer. A path is built only when
+   * it's requested.
+   */
+  class frame_path_list final
+  {
+  public:
+    frame_path_list() = default;
+
+    /**
+     * \brief Construct a list of frame paths.
+     * \param[in] directory The directory that contains the frame images.
+     * \param[in] file_names The file name of each frame image, in frame order.
+     */
+    frame_path_list(const QString& directory, const QStringList& file_names);
+
+    /**
+     * \brief Construct a list of consecutively numbered frame paths.
+     * \param[in] directory The directory that contains the frame images.
+     * \param[in] pattern The pattern of the file names.
+     * \param[in] count The number of frames.
+     */
+    frame_path_list(const QString& directory,
+                    const frame_name_pattern& pattern,
+                    int count);
+
+    /// Get the directory that contains the frame images.
+    [[nodiscard]] auto directory() const -> const QString&;
+
+    /// Get the number of frames.
+    [[nodiscard]] auto size() const noexcept -> int;
+
+    /// Check whether the list has no frames.
+    [[nodiscard]] auto empty() const noexcept -> bool;
+
+    /// Check whether the file names are stored as a numbered pattern.
+    [[nodiscard]] auto is_numbered() const noexcept -> bool;
+
+    /// Get the pattern of the file names, or std::nullopt if they aren't
+    /// numbered.
+    [[nodiscard]] auto pattern() const -> std::optional<frame_name_pattern>;
+
+    /**
+     * \brief Get the file name of one frame image.
+     * \param[in] index The 0-based index of the frame.
+     * \pre \a index is in [0, size()).
+     */
+    [[nodiscard]] auto file_name(int index) const -> QString;
+
+    /**
+     * \brief Get the path to one frame image.
+     * \param[in] index The 0-based index of the frame.
+     * \pre \a index is in [0, size()).
+     */
+    [[nodiscard]] auto operator[](int index) const -> QString;
+
+    /// Build the path to every frame image. This allocates a string per
+    /// frame, so prefer operator[]() for individual frames.
+    [[nodiscard]] auto to_string_list() const -> QStringList;
+
+    /// Get the file name of every frame image, without the directory.
+    [[nodiscard]] auto file_names() const -> QStringList;
+
+  private:
+    QString m_directory;
+    int m_count {0};
+
+    bool m_numbered {false};
+    frame_name_pattern m_pattern;
+
+    // The packed names. Name i is [m_offsets[i], m_offsets[i + 1]).
+    QByteArray m_names;
+    QVector<int> m_offsets;
+  };
+}  // namespace analyzer
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef ANALYZER_LAZY_H
+#define ANALYZER_LAZY_H
+
+#include <memory>
+
+namespace analyzer
+{
+  /**
+   * \brief Hold a value that is derived from other data, and is only computed
+   *    when someone asks for it.
+   * \tparam T The type of the derived value.
+   * \details Multiple threads can call get() at the same time. If two threads
+   * race to compute the value, both compute it but only one result is kept.
+   * The value is immutable once computed, so copies of a lazy share it.
+   *
+   * The owner must call reset() whenever the data the value is derived from
+   * changes. Like any other object, resetting a lazy while other threads read
+   * it is a data race.
+   */
+  template <typename T>
+  class lazy final
+  {
+  public:
+    lazy() = default;
+    ~lazy() = default;
+
+    lazy(const lazy& other): m_value {std::atomic_load(&other.m_value)} {}
+
+    lazy(lazy&& other) noexcept:
+      m_value {std::atomic_load(&other.m_value)}
+    {
+    }
+
+    auto operator=(const lazy& other) -> lazy&
+    {
+      std::atomic_store(&m_value, std::atomic_load(&other.m_value));
+      return *this;
+    }
+
+    auto operator=(lazy&& other) noexcept -> lazy&
+    {
+      std::atomic_store(&m_value, std::atomic_load(&other.m_value));
+      return *this;
+    }
+
+    /**
+     * \brief Get the value, computing it first if necessary.
+     * \param[in] make A function that takes no arguments and returns the
+     *    value. It's only called if the value hasn't been computed yet.
+     * \return A read-only reference to the value. The reference is valid
+     *    until reset() is called, or the lazy object is destroyed.
+     */
+    template <typename Factory>
+    [[nodiscard]] auto get(Factory&& make) const -> const T&
+    {
+      auto value {std::atomic_load(&m_value)};
+      if (value == nullptr)
+      {
+        auto made {std::make_shared<const T>(make())};
+        if (std::atomic_compare_exchange_strong(&m_value, &value, made))
+        {
+          value = made;
+        }
+      }
+      return *value;
+    }
+
+    /// Check whether the value has been computed.
+    [[nodiscard]] auto has_value() const noexcept -> bool
+    {
+      return std::atomic_load(&m_value) != nullptr;
+    }
+
+    /// Throw away the value, so the next call to get() computes it again.
+    void reset() noexcept
+    {
+      std::atomic_store(&m_value, std::shared_ptr<const T> {});
+    }
+
+  private:
+    mutable std::shared_ptr<const T> m_value;
+  };
+}  // namespace analyzer
+
+#endif
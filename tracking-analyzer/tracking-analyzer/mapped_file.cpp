@@ -0,0 +1,38 @@
+#include "tracking-analyzer/mapped_file.h"
+#include <QFile>
+#include <gsl/gsl_util>
+#include <stdexcept>
+
+namespace analyzer
+{
+  mapped_file::mapped_file(const std::string& path):
+    m_file {std::make_unique<QFile>(QString::fromStdString(path))}
+  {
+    if (!m_file->open(QIODevice::ReadOnly))
+    {
+      throw std::runtime_error {"Cannot open " + path};
+    }
+    const auto size {m_file->size()};
+    if (size == 0)
+    {
+      return;
+    }
+    if (const auto* const bytes {m_file->map(0, size)}; bytes != nullptr)
+    {
+      // QFile maps files as unsigned bytes, but the parsers work on chars.
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      m_data = std::string_view {reinterpret_cast<const char*>(bytes),
+                                 gsl::narrow_cast<std::size_t>(size)};
+      return;
+    }
+    const auto contents {m_file->readAll()};
+    m_buffer.assign(contents.constData(),
+                    gsl::narrow_cast<std::size_t>(contents.size()));
+    m_data = m_buffer;
+  }
+
+  // The destructor must be defined where QFile is a complete type.
+  mapped_file::~mapped_file() = default;
+
+  auto mapped_file::data() const noexcept -> std::string_view { return m_data; }
+}  // namespace analyzer
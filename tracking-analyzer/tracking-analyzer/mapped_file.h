@@ -0,0 +1,45 @@
+#ifndef ANALYZER_MAPPED_FILE_H
+#define ANALYZER_MAPPED_FILE_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+class QFile;
+
+namespace analyzer
+{
+  /**
+   * \brief Provide read-only access to the contents of a file, without
+   *    copying them into memory.
+   * \details The file is memory mapped for as long as the mapped_file object
+   * exists. If the operating system can't map the file, for example because
+   * it's a pipe, the contents are read into memory instead. Either way,
+   * data() views the entire file.
+   */
+  class mapped_file final
+  {
+  public:
+    /**
+     * \brief Open and map a file.
+     * \param[in] path The path to the file to map.
+     * \throws std::runtime_error If the file cannot be opened.
+     */
+    explicit mapped_file(const std::string& path);
+    mapped_file(const mapped_file&) = delete;
+    mapped_file(mapped_file&&) = delete;
+    auto operator=(const mapped_file&) -> mapped_file& = delete;
+    auto operator=(mapped_file&&) -> mapped_file& = delete;
+    ~mapped_file();
+
+    /// Get a read-only view of the file's contents.
+    [[nodiscard]] auto data() const noexcept -> std::string_view;
+
+  private:
+    std::unique_ptr<QFile> m_file;
+    std::string m_buffer;
+    std::string_view m_data;
+  };
+}  // namespace analyzer
+
+#endif
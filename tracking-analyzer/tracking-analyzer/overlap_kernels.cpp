@@ -0,0 +1,327 @@
+#include "tracking-analyzer/overlap_kernels.h"
+#include "tracking-analyzer/box_array.h"
+#include <gsl/gsl_assert>
+
+#if defined(__x86_64__)
+#  define ANALYZER_X86_KERNELS
+#  include <immintrin.h>
+#endif
+
+// The vector kernels load four boxes at a time as four floats each, then
+// transpose them into x, y, width, and height vectors.
+static_assert(sizeof(analyzer::bounding_box)
+                == 4 * sizeof(analyzer::bounding_box::value_type),
+              "The overlap kernels require bounding boxes to be 4 packed "
+              "floats.");
+
+namespace analyzer
+{
+  namespace
+  {
+    // Pointers to the coordinate arrays of a box_array. The kernels read
+    // these directly instead of calling box_array functions for every load.
+    struct column_pointers final
+    {
+      explicit column_pointers(const box_array& boxes) noexcept:
+        x {boxes.x().data()},
+        y {boxes.y().data()},
+        width {boxes.width().data()},
+        height {boxes.height().data()},
+        count {boxes.size()}
+      {
+      }
+
+      [[nodiscard]] auto size() const noexcept { return count; }
+
+      [[nodiscard]] auto operator[](const std::size_t i) const noexcept
+      {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return bounding_box {x[i], y[i], width[i], height[i]};
+      }
+
+      const float* x;
+      const float* y;
+      const float* width;
+      const float* height;
+      std::size_t count;
+    };
+
+    template <typename Boxes>
+    void scalar_overlaps(const Boxes& a,
+                         const Boxes& b,
+                         const gsl::span<overlap> overlaps,
+                         std::size_t first)
+    {
+      for (; first < a.size(); ++first)
+      {
+        overlaps[first] = analyzer::calculate_overlap(a[first], b[first]);
+      }
+    }
+
+#ifdef ANALYZER_X86_KERNELS
+    // The operations in these kernels mirror calculate_overlap() exactly, so
+    // the results are bit for bit identical:
+    //   - std::max(a, b) is (a < b) ? b : a, which is _mm_max_ps(b, a).
+    //   - std::min(a, b) is (b < a) ? b : a, which is _mm_min_ps(b, a).
+    //   - The union is (area(a) + area(b)) - area(i), in that order.
+    // Don't enable FMA for these functions; contracting the multiply and
+    // subtract would change the rounding.
+
+    // The x, y, width, and height of 4 boxes, one box per vector lane.
+    struct sse2_boxes final
+    {
+      __m128 x;
+      __m128 y;
+      __m128 width;
+      __m128 height;
+    };
+
+    // The x, y, width, and height of 8 boxes, one box per vector lane.
+    struct avx2_boxes final
+    {
+      __m256 x;
+      __m256 y;
+      __m256 width;
+      __m256 height;
+    };
+
+    [[nodiscard]] auto as_floats(const bounding_box* const box) noexcept
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      return reinterpret_cast<const float*>(box);
+    }
+
+    // Load 4 packed boxes, then transpose them into coordinate vectors.
+    [[nodiscard]] auto load_sse2(const gsl::span<const bounding_box> boxes,
+                                 const std::size_t i) noexcept
+    {
+      const auto* const first {&boxes[i]};
+      sse2_boxes v {_mm_loadu_ps(as_floats(first)),
+                    _mm_loadu_ps(as_floats(first + 1)),   // NOLINT
+                    _mm_loadu_ps(as_floats(first + 2)),   // NOLINT
+                    _mm_loadu_ps(as_floats(first + 3))};  // NOLINT
+      _MM_TRANSPOSE4_PS(v.x, v.y, v.width, v.height);      // NOLINT
+      return v;
+    }
+
+    // Load 4 boxes straight from the coordinate arrays. The arrays start on
+    // 64-byte boundaries and i is a multiple of 4, so aligned loads are safe.
+    [[nodiscard]] auto load_sse2(const column_pointers& boxes,
+                                 const std::size_t i) noexcept
+    {
+      return sse2_boxes {_mm_load_ps(boxes.x + i),        // NOLINT
+                         _mm_load_ps(boxes.y + i),        // NOLINT
+                         _mm_load_ps(boxes.width + i),    // NOLINT
+                         _mm_load_ps(boxes.height + i)};  // NOLINT
+    }
+
+    [[nodiscard]] auto sse2_overlap(const sse2_boxes& a,
+                                    const sse2_boxes& b) noexcept
+    {
+      const auto a_right {_mm_add_ps(a.x, a.width)};
+      const auto a_bottom {_mm_add_ps(a.y, a.height)};
+      const auto b_right {_mm_add_ps(b.x, b.width)};
+      const auto b_bottom {_mm_add_ps(b.y, b.height)};
+      const auto intersects {_mm_and_ps(
+        _mm_and_ps(_mm_cmpgt_ps(a_right, b.x), _mm_cmpgt_ps(b_right, a.x)),
+        _mm_and_ps(_mm_cmpgt_ps(a_bottom, b.y), _mm_cmpgt_ps(b_bottom, a.y)))};
+      const auto ix {_mm_max_ps(b.x, a.x)};
+      const auto iy {_mm_max_ps(b.y, a.y)};
+      const auto iw {_mm_sub_ps(_mm_min_ps(b_right, a_right), ix)};
+      const auto ih {_mm_sub_ps(_mm_min_ps(b_bottom, a_bottom), iy)};
+      const auto i_area {_mm_mul_ps(iw, ih)};
+      const auto union_area {
+        _mm_sub_ps(_mm_add_ps(_mm_mul_ps(a.width, a.height),
+                              _mm_mul_ps(b.width, b.height)),
+                   i_area)};
+      return _mm_and_ps(intersects, _mm_div_ps(i_area, union_area));
+    }
+
+    template <typename Boxes>
+    void sse2_overlaps(const Boxes& a,
+                       const Boxes& b,
+                       const gsl::span<overlap> overlaps)
+    {
+      static constexpr std::size_t width {4};
+      std::size_t i {0};
+      for (; i + width <= a.size(); i += width)
+      {
+        _mm_storeu_ps(&overlaps[i],
+                      sse2_overlap(load_sse2(a, i), load_sse2(b, i)));
+      }
+      scalar_overlaps(a, b, overlaps, i);
+    }
+
+    // The AVX2 helpers pass vectors by reference. Passing 256-bit vectors by
+    // value between functions with different targets changes the ABI.
+
+    // Load boxes i and i + 4 into the low and high lanes of one register.
+    __attribute__((target("avx2"))) void
+    load_box_pair(const bounding_box* const boxes,
+                  const std::size_t i,
+                  __m256& pair) noexcept
+    {
+      pair = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(as_floats(boxes + i))),  // NOLINT
+        _mm_loadu_ps(as_floats(boxes + i + 4)),                       // NOLINT
+        1);
+    }
+
+    // Load 8 packed boxes as coordinate vectors. The 128-bit lanes hold boxes
+    // 0-3 and 4-7, so the in-lane transpose leaves them in order.
+    __attribute__((target("avx2"))) void
+    load_avx2(const gsl::span<const bounding_box> boxes,
+              const std::size_t i,
+              avx2_boxes& v) noexcept
+    {
+      const auto* const first {&boxes[i]};
+      __m256 r0;
+      __m256 r1;
+      __m256 r2;
+      __m256 r3;
+      load_box_pair(first, 0, r0);
+      load_box_pair(first, 1, r1);
+      load_box_pair(first, 2, r2);
+      load_box_pair(first, 3, r3);
+      const auto xy01 {_mm256_unpacklo_ps(r0, r1)};
+      const auto wh01 {_mm256_unpackhi_ps(r0, r1)};
+      const auto xy23 {_mm256_unpacklo_ps(r2, r3)};
+      const auto wh23 {_mm256_unpackhi_ps(r2, r3)};
+      // NOLINTNEXTLINE(hicpp-signed-bitwise)
+      static constexpr int low_pairs {_MM_SHUFFLE(1, 0, 1, 0)};
+      // NOLINTNEXTLINE(hicpp-signed-bitwise)
+      static constexpr int high_pairs {_MM_SHUFFLE(3, 2, 3, 2)};
+      v.x = _mm256_shuffle_ps(xy01, xy23, low_pairs);
+      v.y = _mm256_shuffle_ps(xy01, xy23, high_pairs);
+      v.width = _mm256_shuffle_ps(wh01, wh23, low_pairs);
+      v.height = _mm256_shuffle_ps(wh01, wh23, high_pairs);
+    }
+
+    // Load 8 boxes straight from the coordinate arrays. The arrays start on
+    // 64-byte boundaries and i is a multiple of 8, so aligned loads are safe.
+    __attribute__((target("avx2"))) void
+    load_avx2(const column_pointers& boxes,
+              const std::size_t i,
+              avx2_boxes& v) noexcept
+    {
+      v.x = _mm256_load_ps(boxes.x + i);            // NOLINT
+      v.y = _mm256_load_ps(boxes.y + i);            // NOLINT
+      v.width = _mm256_load_ps(boxes.width + i);    // NOLINT
+      v.height = _mm256_load_ps(boxes.height + i);  // NOLINT
+    }
+
+    __attribute__((target("avx2"))) void
+    avx2_overlap(const avx2_boxes& a,
+                 const avx2_boxes& b,
+                 overlap* const overlaps) noexcept
+    {
+      const auto a_right {_mm256_add_ps(a.x, a.width)};
+      const auto a_bottom {_mm256_add_ps(a.y, a.height)};
+      const auto b_right {_mm256_add_ps(b.x, b.width)};
+      const auto b_bottom {_mm256_add_ps(b.y, b.height)};
+      const auto intersects {
+        _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(a_right, b.x, _CMP_GT_OQ),
+                                    _mm256_cmp_ps(b_right, a.x, _CMP_GT_OQ)),
+                      _mm256_and_ps(_mm256_cmp_ps(a_bottom, b.y, _CMP_GT_OQ),
+                                    _mm256_cmp_ps(b_bottom, a.y, _CMP_GT_OQ)))};
+      const auto ix {_mm256_max_ps(b.x, a.x)};
+      const auto iy {_mm256_max_ps(b.y, a.y)};
+      const auto iw {_mm256_sub_ps(_mm256_min_ps(b_right, a_right), ix)};
+      const auto ih {_mm256_sub_ps(_mm256_min_ps(b_bottom, a_bottom), iy)};
+      const auto i_area {_mm256_mul_ps(iw, ih)};
+      const auto union_area {
+        _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(a.width, a.height),
+                                    _mm256_mul_ps(b.width, b.height)),
+                      i_area)};
+      _mm256_storeu_ps(
+        overlaps, _mm256_and_ps(intersects, _mm256_div_ps(i_area, union_area)));
+    }
+
+    template <typename Boxes>
+    __attribute__((target("avx2"))) void
+    avx2_overlaps(const Boxes& a,
+                  const Boxes& b,
+                  const gsl::span<overlap> overlaps)
+    {
+      static constexpr std::size_t width {8};
+      std::size_t i {0};
+      avx2_boxes va;
+      avx2_boxes vb;
+      for (; i + width <= a.size(); i += width)
+      {
+        load_avx2(a, i, va);
+        load_avx2(b, i, vb);
+        avx2_overlap(va, vb, &overlaps[i]);
+      }
+      scalar_overlaps(a, b, overlaps, i);
+    }
+#endif
+
+    // Run the kernel for the requested instruction set, if this CPU supports
+    // it. Otherwise, run the scalar kernel.
+    template <typename Boxes>
+    void dispatch_overlaps(const Boxes& a,
+                           const Boxes& b,
+                           const gsl::span<overlap> overlaps,
+                           const instruction_set isa)
+    {
+      Expects(a.size() == b.size() && a.size() == overlaps.size());
+#ifdef ANALYZER_X86_KERNELS
+      if (isa == instruction_set::avx2 && is_supported(instruction_set::avx2))
+      {
+        avx2_overlaps(a, b, overlaps);
+        return;
+      }
+      if (isa == instruction_set::sse2 && is_supported(instruction_set::sse2))
+      {
+        sse2_overlaps(a, b, overlaps);
+        return;
+      }
+#endif
+      scalar_overlaps(a, b, overlaps, 0);
+    }
+  }  // namespace
+
+  auto is_supported(const instruction_set isa) noexcept -> bool
+  {
+    switch (isa)
+    {
+#ifdef ANALYZER_X86_KERNELS
+      case instruction_set::avx2:
+        return __builtin_cpu_supports("avx2") != 0;
+      case instruction_set::sse2:
+        return __builtin_cpu_supports("sse2") != 0;
+#endif
+      case instruction_set::scalar:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  auto best_instruction_set() noexcept -> instruction_set
+  {
+    static const auto best {is_supported(instruction_set::avx2)
+                              ? instruction_set::avx2
+                              : is_supported(instruction_set::sse2)
+                                  ? instruction_set::sse2
+                                  : instruction_set::scalar};
+    return best;
+  }
+
+  void calculate_overlaps(const gsl::span<const bounding_box> a,
+                          const gsl::span<const bounding_box> b,
+                          const gsl::span<overlap> overlaps,
+                          const instruction_set isa)
+  {
+    dispatch_overlaps(a, b, overlaps, isa);
+  }
+
+  void calculate_overlaps(const box_array& a,
+                          const box_array& b,
+                          const gsl::span<overlap> overlaps,
+                          const instruction_set isa)
+  {
+    dispatch_overlaps(column_pointers {a}, column_pointers {b}, overlaps, isa);
+  }
+}  // namespace analyzer
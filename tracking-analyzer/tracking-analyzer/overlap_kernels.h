@@ -0,0 +1,70 @@
+#ifndef ANALYZER_OVERLAP_KERNELS_H
+#define ANALYZER_OVERLAP_KERNELS_H
+
+#include "tracking-analyzer/bounding_box.h"
+#include <gsl/span>
+
+namespace analyzer
+{
+  class box_array;
+
+  /// The instruction sets the batch overlap kernel can use.
+  enum class instruction_set
+  {
+    scalar,
+    sse2,
+    avx2
+  };
+
+  /**
+   * \brief Get the widest instruction set this CPU supports.
+   * \return The best instruction set for calculate_overlaps(). On CPUs other
+   *    than x86, this is always instruction_set::scalar.
+   */
+  [[nodiscard]] auto best_instruction_set() noexcept -> instruction_set;
+
+  /**
+   * \brief Check whether this CPU can run a specific instruction set.
+   * \param[in] isa The instruction set to check.
+   * \return True if calculate_overlaps() can use \a isa on this CPU.
+   */
+  [[nodiscard]] auto is_supported(instruction_set isa) noexcept -> bool;
+
+  /**
+   * \brief Calculate the overlap of many pairs of bounding boxes.
+   * \param[in] a The first box of each pair.
+   * \param[in] b The second box of each pair.
+   * \param[out] overlaps Receives the overlap for each pair. It must be the
+   *    same size as \a a and \a b.
+   * \param[in] isa The instruction set to use. If this CPU doesn't support
+   *    \a isa, the scalar kernel is used.
+   * \details The vector kernels compute the overlap without branches: they
+   * compute the intersection-over-union for every pair, then mask out pairs
+   * that don't intersect. For finite coordinates, the results are bit for bit
+   * the same as calculate_overlap(const bounding_box&, const bounding_box&).
+   */
+  void calculate_overlaps(gsl::span<const analyzer::bounding_box> a,
+                          gsl::span<const analyzer::bounding_box> b,
+                          gsl::span<analyzer::overlap> overlaps,
+                          instruction_set isa);
+
+  /**
+   * \brief Calculate the overlap of many pairs of bounding boxes stored as
+   *    structures of arrays.
+   * \param[in] a The first box of each pair.
+   * \param[in] b The second box of each pair.
+   * \param[out] overlaps Receives the overlap for each pair. It must be the
+   *    same size as \a a and \a b.
+   * \param[in] isa The instruction set to use. If this CPU doesn't support
+   *    \a isa, the scalar kernel is used.
+   * \details This kernel loads the coordinates straight from the aligned
+   * arrays, so it skips the transpose the bounding_box kernel needs. The
+   * results are the same as for the bounding_box kernel.
+   */
+  void calculate_overlaps(const analyzer::box_array& a,
+                          const analyzer::box_array& b,
+                          gsl::span<analyzer::overlap> overlaps,
+                          instruction_set isa);
+}  // namespace analyzer
+
+#endif
@@ -0,0 +1,70 @@
+#include "tracking-analyzer/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace analyzer
+{
+  auto default_worker_count() noexcept -> unsigned int
+  {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  void parallel_for(const std::size_t count,
+                    const unsigned int worker_count,
+                    const std::function<void(std::size_t)>& task)
+  {
+    const auto workers {std::min<std::size_t>(
+      worker_count == 0 ? default_worker_count() : worker_count, count)};
+    if (workers <= 1)
+    {
+      for (std::size_t i {0}; i < count; ++i)
+      {
+        task(i);
+      }
+      return;
+    }
+
+    std::atomic<std::size_t> next_index {0};
+    std::atomic<bool> stop {false};
+    std::exception_ptr first_exception;
+    std::mutex exception_mutex;
+    const auto work {[&]() {
+      for (auto i {next_index++}; i < count && !stop; i = next_index++)
+      {
+        try
+        {
+          task(i);
+        }
+        catch (...)
+        {
+          const std::lock_guard lock {exception_mutex};
+          if (!first_exception)
+          {
+            first_exception = std::current_exception();
+          }
+          stop = true;
+        }
+      }
+    }};
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t i {1}; i < workers; ++i)
+    {
+      threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    if (first_exception)
+    {
+      std::rethrow_exception(first_exception);
+    }
+  }
+}  // namespace analyzer
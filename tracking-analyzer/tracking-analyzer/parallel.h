@@ -0,0 +1,36 @@
+#ifndef ANALYZER_PARALLEL_H
+#define ANALYZER_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace analyzer
+{
+  /**
+   * \brief Get the number of worker threads to use when the caller doesn't
+   *    request a specific number.
+   * \return The number of hardware threads, or 1 if the number is unknown.
+   */
+  [[nodiscard]] auto default_worker_count() noexcept -> unsigned int;
+
+  /**
+   * \brief Run a task for each index in [0, count) on a pool of threads.
+   * \param[in] count The number of indices to process.
+   * \param[in] worker_count The maximum number of threads to use. Zero means
+   *    use default_worker_count(). The calling thread is one of the workers.
+   * \param[in] task The function to call for each index. It must be safe to
+   *    call concurrently with different indices.
+   * \throws Any exception thrown by \a task. The first exception stops workers
+   *    from starting new indices, and parallel_for() rethrows it after all
+   *    workers finish.
+   * \details Workers pull indices from a shared counter, so there is no
+   * guarantee which thread processes an index, or in what order indices are
+   * processed. Tasks that need deterministic output should write to a slot
+   * reserved for their index.
+   */
+  void parallel_for(std::size_t count,
+                    unsigned int worker_count,
+                    const std::function<void(std::size_t)>& task);
+}  // namespace analyzer
+
+#endif
@@ -0,0 +1,253 @@
+#include "tracking-analyzer/results_cache.h"
+#include "tracking-analyzer/mapped_file.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <array>
+#include <cstring>
+#include <gsl/gsl_util>
+#include <stdexcept>
+#include <type_traits>
+
+namespace analyzer
+{
+  namespace
+  {
+    constexpr std::array<char, 8> magic {'T', 'A', 'C', 'A', 'C', 'H', 'E', 0};
+
+    // A machine with a different byte order reads this as a different number.
+    constexpr std::uint32_t byte_order_mark {0x01020304};
+
+    // Boxes start on a 16-byte boundary, so a mapped cache file could be read
+    // with aligned vector loads.
+    constexpr std::uint64_t box_alignment {16};
+
+    struct file_header final
+    {
+      std::array<char, 8> magic;
+      std::uint32_t version;
+      std::uint32_t byte_order;
+      std::uint64_t record_count;
+      std::uint64_t records_offset;
+      std::uint64_t strings_offset;
+      std::uint64_t strings_size;
+      std::uint64_t boxes_offset;
+      std::uint64_t box_count;
+    };
+
+    struct file_record final
+    {
+      std::uint64_t source_offset;
+      std::uint64_t source_size;
+      std::int64_t stamp_size;
+      std::int64_t stamp_modified;
+      std::uint64_t first_box;
+      std::uint64_t box_count;
+    };
+
+    static_assert(std::is_trivially_copyable_v<file_header>);
+    static_assert(std::is_trivially_copyable_v<file_record>);
+    static_assert(sizeof(file_header) == 64);
+    static_assert(sizeof(file_record) == 48);
+    static_assert(sizeof(bounding_box) == 16);
+
+    // The mapped data has no particular alignment, so copy the bytes into a
+    // properly aligned object.
+    template <typename T>
+    [[nodiscard]] auto read_object(const std::string_view data,
+                                   const std::uint64_t offset)
+    {
+      T object;
+      std::memcpy(&object, data.data() + offset, sizeof(T));  // NOLINT
+      return object;
+    }
+
+    template <typename T>
+    void append_object(std::string& buffer, const T& object)
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      buffer.append(reinterpret_cast<const char*>(&object), sizeof(T));
+    }
+
+    // Check that [offset, offset + count * size) fits within the file, without
+    // overflowing.
+    [[nodiscard]] auto fits(const std::uint64_t file_size,
+                            const std::uint64_t offset,
+                            const std::uint64_t count,
+                            const std::uint64_t size) noexcept
+    {
+      return offset <= file_size && count <= (file_size - offset) / size;
+    }
+
+    [[nodiscard]] auto is_valid(const file_header& header,
+                                const std::uint64_t file_size) noexcept
+    {
+      return header.magic == magic && header.version == results_cache_version
+             && header.byte_order == byte_order_mark
+             && fits(file_size,
+                     header.records_offset,
+                     header.record_count,
+                     sizeof(file_record))
+             && fits(file_size, header.strings_offset, header.strings_size, 1)
+             && fits(file_size,
+                     header.boxes_offset,
+                     header.box_count,
+                     sizeof(bounding_box));
+    }
+
+    [[nodiscard]] auto is_valid(const file_record& record,
+                                const file_header& header) noexcept
+    {
+      return fits(header.strings_size,
+                  record.source_offset,
+                  record.source_size,
+                  1)
+             && fits(header.box_count, record.first_box, record.box_count, 1);
+    }
+  }  // namespace
+
+  auto stamp_file(const std::string& path) -> file_stamp
+  {
+    const QFileInfo info {QString::fromStdString(path)};
+    if (!info.exists())
+    {
+      return file_stamp {};
+    }
+    return file_stamp {info.size(), info.lastModified().toMSecsSinceEpoch()};
+  }
+
+  void write_results_cache(const std::string& path,
+                           const std::vector<cache_record>& records)
+  {
+    std::string strings;
+    std::uint64_t box_count {0};
+    std::vector<file_record> table;
+    table.reserve(records.size());
+    for (const auto& record : records)
+    {
+      table.push_back(file_record {strings.size(),
+                                   record.source.size(),
+                                   record.stamp.size,
+                                   record.stamp.modified,
+                                   box_count,
+                                   record.boxes.size()});
+      strings += record.source;
+      box_count += record.boxes.size();
+    }
+
+    file_header header {};
+    header.magic = magic;
+    header.version = results_cache_version;
+    header.byte_order = byte_order_mark;
+    header.record_count = table.size();
+    header.records_offset = sizeof(file_header);
+    header.strings_offset
+      = header.records_offset + table.size() * sizeof(file_record);
+    header.strings_size = strings.size();
+    header.boxes_offset
+      = (header.strings_offset + strings.size() + box_alignment - 1)
+        / box_alignment * box_alignment;
+    header.box_count = box_count;
+
+    std::string buffer;
+    buffer.reserve(header.boxes_offset + box_count * sizeof(bounding_box));
+    append_object(buffer, header);
+    for (const auto& record : table)
+    {
+      append_object(buffer, record);
+    }
+    buffer += strings;
+    buffer.resize(header.boxes_offset, '\0');
+    for (const auto& record : records)
+    {
+      if (!record.boxes.empty())
+      {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        buffer.append(reinterpret_cast<const char*>(record.boxes.data()),
+                      record.boxes.size_bytes());
+      }
+    }
+
+    const auto qpath {QString::fromStdString(path)};
+    QDir {}.mkpath(QFileInfo {qpath}.absolutePath());
+    QSaveFile file {qpath};
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(buffer.data(), gsl::narrow_cast<qint64>(buffer.size()))
+             != gsl::narrow_cast<qint64>(buffer.size())
+        || !file.commit())
+    {
+      throw std::runtime_error {"Cannot write the results cache " + path + ": "
+                                + file.errorString().toStdString()};
+    }
+  }
+
+  results_cache::results_cache(const std::string& path)
+  {
+    if (!QFileInfo::exists(QString::fromStdString(path)))
+    {
+      return;
+    }
+    try
+    {
+      m_file = std::make_unique<mapped_file>(path);
+    }
+    catch (const std::runtime_error&)
+    {
+      return;
+    }
+    const auto data {m_file->data()};
+    if (data.size() < sizeof(file_header))
+    {
+      return;
+    }
+    const auto header {read_object<file_header>(data, 0)};
+    if (!is_valid(header, data.size()))
+    {
+      return;
+    }
+    m_records.reserve(header.record_count);
+    for (std::uint64_t i {0}; i < header.record_count; ++i)
+    {
+      const auto r {read_object<file_record>(
+        data, header.records_offset + i * sizeof(file_record))};
+      if (!is_valid(r, header))
+      {
+        m_records.clear();
+        return;
+      }
+      m_records.emplace(
+        data.substr(header.strings_offset + r.source_offset, r.source_size),
+        record {file_stamp {r.stamp_size, r.stamp_modified},
+                data.substr(header.boxes_offset
+                              + r.first_box * sizeof(bounding_box),
+                            r.box_count * sizeof(bounding_box))});
+    }
+  }
+
+  // The destructor must be defined where mapped_file is a complete type.
+  results_cache::~results_cache() = default;
+
+  auto results_cache::size() const noexcept -> std::size_t
+  {
+    return m_records.size();
+  }
+
+  auto results_cache::find(const std::string_view source,
+                           const file_stamp& stamp) const
+    -> std::optional<bounding_box_list>
+  {
+    const auto i {m_records.find(source)};
+    if (i == std::end(m_records) || i->second.stamp != stamp)
+    {
+      return std::nullopt;
+    }
+    const auto bytes {i->second.boxes};
+    bounding_box_list boxes(bytes.size() / sizeof(bounding_box));
+    if (!boxes.empty())
+    {
+      std::memcpy(boxes.data(), bytes.data(), bytes.size());
+    }
+    return boxes;
+  }
+}  // namespace analyzer
@@ -0,0 +1,141 @@
+#ifndef ANALYZER_RESULTS_CACHE_H
+#define ANALYZER_RESULTS_CACHE_H
+
+#include "tracking-analyzer/bounding_box.h"
+#include <cstdint>
+#include <gsl/span>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace analyzer
+{
+  class mapped_file;
+
+  /// The version of the results cache file format. Cache files with a
+  /// different version are ignored.
+  constexpr std::uint32_t results_cache_version {1};
+
+  /**
+   * \brief Identify one version of a file by its size and modification time.
+   * \details If either the size or the modification time of a source file
+   * changes, its cached boxes are stale.
+   */
+  struct file_stamp final
+  {
+    /// The size of the file in bytes, or -1 if the file doesn't exist.
+    std::int64_t size {-1};
+
+    /// The modification time, in milliseconds since the Unix epoch.
+    std::int64_t modified {0};
+  };
+
+  [[nodiscard]] inline auto operator==(const file_stamp& a,
+                                       const file_stamp& b) noexcept
+  {
+    return a.size == b.size && a.modified == b.modified;
+  }
+
+  [[nodiscard]] inline auto operator!=(const file_stamp& a,
+                                       const file_stamp& b) noexcept
+  {
+    return !(a == b);
+  }
+
+  /**
+   * \brief Get the current stamp of a file.
+   * \param[in] path The path to the file.
+   * \return The size and modification time of the file. If the file doesn't
+   *    exist, the size is -1.
+   */
+  [[nodiscard]] auto stamp_file(const std::string& path) -> file_stamp;
+
+  /// The boxes for one source file, to write to a results cache.
+  struct cache_record final
+  {
+    /// The path to the source file, relative to the results directory. For
+    /// example, "MDNet/Deer.txt".
+    std::string source;
+
+    /// The stamp of the source file when its boxes were read.
+    file_stamp stamp;
+
+    /// The boxes read from the source file.
+    gsl::span<const bounding_box> boxes;
+  };
+
+  /**
+   * \brief Write a results cache file.
+   * \param[in] path The path to the cache file to write. If the file exists,
+   *    it's replaced. The replacement is atomic, so a crash never leaves a
+   *    partial cache file behind.
+   * \param[in] records The boxes to write, one record per source file.
+   * \throws std::runtime_error If the cache file cannot be written.
+   * \details The cache file has four parts:
+   *   1. A fixed size header with a magic number, the format version, and the
+   *      offsets of the other parts.
+   *   2. A table of records, each with a source path, a file stamp, and a
+   *      range of boxes.
+   *   3. A string table with all the source paths.
+   *   4. The boxes for all the records, as contiguous floats.
+   *
+   * Numbers are stored in the byte order of the machine that wrote the file.
+   * A machine with a different byte order sees the cache as invalid.
+   */
+  void write_results_cache(const std::string& path,
+                           const std::vector<cache_record>& records);
+
+  /**
+   * \brief Provide read-only access to a results cache file.
+   * \details The cache file is memory mapped, and stays mapped for the
+   * lifetime of the results_cache object. Looking up a record doesn't parse
+   * any text; the boxes are copied straight out of the mapped file.
+   */
+  class results_cache final
+  {
+  public:
+    /**
+     * \brief Open a results cache file.
+     * \param[in] path The path to the cache file.
+     * \details If the file doesn't exist, or isn't a valid cache file for
+     * this version of the format, the cache is empty. A missing or outdated
+     * cache isn't an error; it just means everything has to be parsed again.
+     */
+    explicit results_cache(const std::string& path);
+    results_cache(const results_cache&) = delete;
+    results_cache(results_cache&&) = delete;
+    auto operator=(const results_cache&) -> results_cache& = delete;
+    auto operator=(results_cache&&) -> results_cache& = delete;
+    ~results_cache();
+
+    /// Get the number of records in the cache.
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    /**
+     * \brief Get the cached boxes for a source file.
+     * \param[in] source The path to the source file, relative to the results
+     *    directory.
+     * \param[in] stamp The current stamp of the source file.
+     * \return The cached boxes, if the cache has a record for \a source and
+     *    the record's stamp equals \a stamp. Otherwise, std::nullopt.
+     */
+    [[nodiscard]] auto find(std::string_view source,
+                            const file_stamp& stamp) const
+      -> std::optional<bounding_box_list>;
+
+  private:
+    struct record final
+    {
+      file_stamp stamp;
+      std::string_view boxes;
+    };
+
+    std::unique_ptr<mapped_file> m_file;
+    std::unordered_map<std::string_view, record> m_records;
+  };
+}  // namespace analyzer
+
+#endif
@@ -0,0 +1,417 @@
+#include "tracking-analyzer/synthetic_data.h"
+#include "tracking-analyzer/parallel.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <gsl/gsl_util>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+
+namespace analyzer
+{
+  namespace
+  {
+    // The widths of the numbers in sequence and tracker names. They limit the
+    // counts, so the names sort in index order.
+    constexpr int sequence_digits {5};
+    constexpr int maximum_sequence_count {99'999};
+    constexpr int tracker_digits {3};
+    constexpr int maximum_tracker_count {999};
+    constexpr int minimum_frame_size {16};
+
+    // Targets are 5% to 25% of the frame width, and move at most this many
+    // pixels per frame.
+    constexpr float minimum_target_size {0.05f};
+    constexpr float maximum_target_size {0.25f};
+    constexpr float maximum_speed {8.0f};
+
+    // Tracker errors carry over from frame to frame, shrinking by this factor,
+    // so the results drift like a real tracker's instead of jittering.
+    constexpr float error_decay {0.9f};
+
+    // A tracker with error e loses the target in a frame with probability
+    // e * failure_rate.
+    constexpr float failure_rate {0.01f};
+
+    // Each kind of random choice gets its own stream, so changing one option
+    // doesn't change the choices that don't depend on it. For example, adding
+    // trackers doesn't change the ground truth.
+    enum class stream : std::uint32_t
+    {
+      frame_count,
+      trajectory,
+      attributes,
+      tracker_accuracy,
+      tracker_error
+    };
+
+    // The standard distributions are implementation defined, so they could
+    // make different data with different standard libraries. This only uses
+    // the raw output of std::mt19937, which the standard does define.
+    class random_source final
+    {
+    public:
+      random_source(const std::uint32_t seed,
+                    const stream kind,
+                    const int first,
+                    const int second = 0)
+      {
+        std::seed_seq sequence {seed,
+                                static_cast<std::uint32_t>(kind),
+                                gsl::narrow_cast<std::uint32_t>(first),
+                                gsl::narrow_cast<std::uint32_t>(second)};
+        m_generator.seed(sequence);
+      }
+
+      // Get a number in [low, high).
+      auto uniform(const float low, const float high) -> float
+      {
+        // 24 bits fill a float's significand exactly.
+        constexpr int bits {24};
+        const auto unit {std::ldexp(
+          static_cast<float>(m_generator() >> (32 - bits)), -bits)};
+        return low + (high - low) * unit;
+      }
+
+      // Get an integer in [low, high].
+      auto integer(const int low, const int high) -> int
+      {
+        const auto count {static_cast<std::uint64_t>(high - low) + 1};
+        return low + gsl::narrow_cast<int>(m_generator() % count);
+      }
+
+      auto chance(const float probability) -> bool
+      {
+        return uniform(0.0f, 1.0f) < probability;
+      }
+
+    private:
+      std::mt19937 m_generator;
+    };
+
+    void validate(const synthetic_options& options)
+    {
+      if (options.sequence_count < 0
+          || options.sequence_count > maximum_sequence_count)
+      {
+        throw std::invalid_argument {"The sequence count must be in [0, "
+                                     + std::to_string(maximum_sequence_count)
+                                     + "]."};
+      }
+      if (options.tracker_count < 0
+          || options.tracker_count > maximum_tracker_count)
+      {
+        throw std::invalid_argument {"The tracker count must be in [0, "
+                                     + std::to_string(maximum_tracker_count)
+                                     + "]."};
+      }
+      if (options.minimum_frame_count < 1
+          || options.maximum_frame_count < options.minimum_frame_count)
+      {
+        throw std::invalid_argument {
+          "The minimum frame count must be at least 1, and not more than the "
+          "maximum frame count."};
+      }
+      if (options.frame_width < minimum_frame_size
+          || options.frame_height < minimum_frame_size)
+      {
+        throw std::invalid_argument {"The frames must be at least "
+                                     + std::to_string(minimum_frame_size)
+                                     + " pixels wide and high."};
+      }
+    }
+
+    void check_index(const int index, const int count, const char* name)
+    {
+      if (index < 0 || index >= count)
+      {
+        throw std::invalid_argument {std::string {"The "} + name + " index "
+                                     + std::to_string(index)
+                                     + " is out of range."};
+      }
+    }
+
+    auto numbered_name(const std::string_view prefix,
+                       const int number,
+                       const int digits)
+    {
+      auto name {std::to_string(number)};
+      if (gsl::narrow_cast<int>(name.size()) < digits)
+      {
+        const auto padding {gsl::narrow_cast<std::size_t>(digits)
+                            - name.size()};
+        name.insert(0, padding, '0');
+      }
+      return std::string {prefix} + name;
+    }
+
+    // Move a center coordinate, bouncing off the edges of [low, high].
+    auto bounce(const float position,
+                const float low,
+                const float high,
+                float& velocity)
+    {
+      if (position < low)
+      {
+        velocity = -velocity;
+        return std::min(2.0f * low - position, high);
+      }
+      if (position > high)
+      {
+        velocity = -velocity;
+        return std::max(2.0f * high - position, low);
+      }
+      return position;
+    }
+
+    auto round_to_hundredths(const float value)
+    {
+      return std::round(value * 100.0f) / 100.0f;
+    }
+
+    void append_number(std::string& text, const float value)
+    {
+      std::array<char, 32> buffer {};
+      const auto result {
+        std::to_chars(buffer.data(), buffer.data() + buffer.size(), value)};
+      text.append(buffer.data(), result.ptr);
+    }
+
+    void write_file(const std::filesystem::path& path,
+                    const std::string_view text)
+    {
+      std::ofstream file {path, std::ios::binary};
+      file.write(text.data(), gsl::narrow<std::streamsize>(text.size()));
+      if (!file)
+      {
+        throw std::runtime_error {"Cannot write " + path.string()};
+      }
+    }
+
+    void write_boxes(const std::filesystem::path& path,
+                     const bounding_box_list& boxes)
+    {
+      std::string text;
+      for (const auto& box : boxes)
+      {
+        append_number(text, box.x);
+        text += ',';
+        append_number(text, box.y);
+        text += ',';
+        append_number(text, box.width);
+        text += ',';
+        append_number(text, box.height);
+        text += '\n';
+      }
+      write_file(path, text);
+    }
+
+    // Frames are numbered from 1 with at least 4 digits, like OTB.
+    void write_frames(const std::filesystem::path& directory,
+                      const bounding_box_list::size_type frame_count)
+    {
+      constexpr int minimum_digits {4};
+      const auto digits {std::max(
+        minimum_digits,
+        gsl::narrow_cast<int>(std::to_string(frame_count).size()))};
+      for (bounding_box_list::size_type i {1}; i <= frame_count; ++i)
+      {
+        write_file(
+          directory / (numbered_name("", gsl::narrow<int>(i), digits) + ".jpg"),
+          {});
+      }
+    }
+
+    // The dataset loader needs at least one attribute in attrs.txt.
+    auto make_attributes(const synthetic_options& options, const int sequence)
+    {
+      static constexpr std::array<std::string_view, 11> abbreviations {
+        "IV", "SV", "OCC", "DEF", "MB", "FM", "IPR", "OPR", "OV", "BC", "LR"};
+      constexpr float attribute_chance {0.3f};
+      random_source random {options.seed, stream::attributes, sequence};
+      std::string text;
+      for (const auto abbreviation : abbreviations)
+      {
+        if (random.chance(attribute_chance))
+        {
+          text += (text.empty() ? "" : ", ") + std::string {abbreviation};
+        }
+      }
+      if (text.empty())
+      {
+        const auto last {gsl::narrow_cast<int>(abbreviations.size()) - 1};
+        text = abbreviations.at(
+          gsl::narrow_cast<std::size_t>(random.integer(0, last)));
+      }
+      return text + '\n';
+    }
+  }  // namespace
+
+  auto synthetic_sequence_name(const int sequence) -> std::string
+  {
+    return numbered_name("sequence", sequence, sequence_digits);
+  }
+
+  auto synthetic_tracker_name(const int tracker) -> std::string
+  {
+    return numbered_name("tracker", tracker, tracker_digits);
+  }
+
+  auto make_synthetic_ground_truth(const synthetic_options& options,
+                                   const int sequence) -> bounding_box_list
+  {
+    validate(options);
+    check_index(sequence, options.sequence_count, "sequence");
+    const auto frame_count {
+      random_source {options.seed, stream::frame_count, sequence}.integer(
+        options.minimum_frame_count, options.maximum_frame_count)};
+    random_source random {options.seed, stream::trajectory, sequence};
+    const auto frame_width {static_cast<float>(options.frame_width)};
+    const auto frame_height {static_cast<float>(options.frame_height)};
+    const auto base_width {
+      random.uniform(minimum_target_size, maximum_target_size) * frame_width};
+    const auto base_height {
+      std::min(base_width * random.uniform(0.5f, 2.0f), frame_height / 2.0f)};
+    auto scale {1.0f};
+    auto x_velocity {random.uniform(-maximum_speed, maximum_speed) / 2.0f};
+    auto y_velocity {random.uniform(-maximum_speed, maximum_speed) / 2.0f};
+    auto center_x {random.uniform(base_width, frame_width - base_width)};
+    auto center_y {random.uniform(base_height, frame_height - base_height)};
+    bounding_box_list boxes;
+    boxes.reserve(gsl::narrow_cast<bounding_box_list::size_type>(frame_count));
+    for (int frame {0}; frame < frame_count; ++frame)
+    {
+      const auto width {base_width * scale};
+      const auto height {base_height * scale};
+      const auto rounded_width {std::max(1.0f, std::round(width))};
+      const auto rounded_height {std::max(1.0f, std::round(height))};
+      boxes.push_back({std::clamp(std::round(center_x - width / 2.0f),
+                                  0.0f,
+                                  frame_width - rounded_width),
+                       std::clamp(std::round(center_y - height / 2.0f),
+                                  0.0f,
+                                  frame_height - rounded_height),
+                       rounded_width,
+                       rounded_height});
+
+      x_velocity = std::clamp(x_velocity + random.uniform(-0.5f, 0.5f),
+                              -maximum_speed,
+                              maximum_speed);
+      y_velocity = std::clamp(y_velocity + random.uniform(-0.5f, 0.5f),
+                              -maximum_speed,
+                              maximum_speed);
+      scale = std::clamp(scale * random.uniform(0.99f, 1.01f), 0.5f, 1.5f);
+      const auto half_width {base_width * scale / 2.0f};
+      const auto half_height {base_height * scale / 2.0f};
+      center_x = bounce(center_x + x_velocity,
+                        half_width,
+                        frame_width - half_width,
+                        x_velocity);
+      center_y = bounce(center_y + y_velocity,
+                        half_height,
+                        frame_height - half_height,
+                        y_velocity);
+    }
+    return boxes;
+  }
+
+  auto make_synthetic_results(const synthetic_options& options,
+                              const bounding_box_list& ground_truth,
+                              const int tracker,
+                              const int sequence) -> bounding_box_list
+  {
+    validate(options);
+    check_index(tracker, options.tracker_count, "tracker");
+    // A tracker is equally accurate on every sequence.
+    const auto error {
+      random_source {options.seed, stream::tracker_accuracy, tracker}.uniform(
+        0.02f, 0.3f)};
+    random_source random {
+      options.seed, stream::tracker_error, tracker, sequence};
+    auto x_offset {0.0f};
+    auto y_offset {0.0f};
+    auto size_error {0.0f};
+    bounding_box_list results;
+    results.reserve(ground_truth.size());
+    for (const auto& truth : ground_truth)
+    {
+      if (results.empty())
+      {
+        results.push_back(truth);
+        continue;
+      }
+      x_offset = error_decay * x_offset
+                 + random.uniform(-error, error) * truth.width;
+      y_offset = error_decay * y_offset
+                 + random.uniform(-error, error) * truth.height;
+      size_error = error_decay * size_error
+                   + random.uniform(-error, error) / 4.0f;
+      if (random.chance(error * failure_rate))
+      {
+        x_offset += random.uniform(-2.0f, 2.0f) * truth.width;
+        y_offset += random.uniform(-2.0f, 2.0f) * truth.height;
+      }
+      const auto width {std::max(1.0f, truth.width * (1.0f + size_error))};
+      const auto height {std::max(1.0f, truth.height * (1.0f + size_error))};
+      const auto center {calculate_center(truth)};
+      results.push_back(
+        {round_to_hundredths(center.x + x_offset - width / 2.0f),
+         round_to_hundredths(center.y + y_offset - height / 2.0f),
+         round_to_hundredths(width),
+         round_to_hundredths(height)});
+    }
+    return results;
+  }
+
+  void write_synthetic_dataset(const std::string& path,
+                               const synthetic_options& options)
+  {
+    validate(options);
+    const std::filesystem::path root {path};
+    parallel_for(
+      gsl::narrow_cast<std::size_t>(options.sequence_count),
+      options.worker_count,
+      [&root, &options](const std::size_t i) {
+        const auto sequence {gsl::narrow_cast<int>(i)};
+        const auto directory {root / synthetic_sequence_name(sequence)};
+        std::filesystem::create_directories(directory / "img");
+        const auto ground_truth {
+          make_synthetic_ground_truth(options, sequence)};
+        write_frames(directory / "img", ground_truth.size());
+        write_boxes(directory / "groundtruth_rect.txt", ground_truth);
+        write_file(directory / "attrs.txt", make_attributes(options, sequence));
+      });
+  }
+
+  void write_synthetic_results(const std::string& path,
+                               const synthetic_options& options)
+  {
+    validate(options);
+    const std::filesystem::path root {path};
+    for (int tracker {0}; tracker < options.tracker_count; ++tracker)
+    {
+      std::filesystem::create_directories(root
+                                          / synthetic_tracker_name(tracker));
+    }
+    // Each sequence's ground truth is made once, for all the trackers.
+    parallel_for(
+      gsl::narrow_cast<std::size_t>(options.sequence_count),
+      options.worker_count,
+      [&root, &options](const std::size_t i) {
+        const auto sequence {gsl::narrow_cast<int>(i)};
+        const auto ground_truth {
+          make_synthetic_ground_truth(options, sequence)};
+        const auto file_name {synthetic_sequence_name(sequence) + ".txt"};
+        for (int tracker {0}; tracker < options.tracker_count; ++tracker)
+        {
+          write_boxes(root / synthetic_tracker_name(tracker) / file_name,
+                      make_synthetic_results(
+                        options, ground_truth, tracker, sequence));
+        }
+      });
+  }
+}  // namespace analyzer
@@ -0,0 +1,117 @@
+#ifndef ANALYZER_SYNTHETIC_DATA_H
+#define ANALYZER_SYNTHETIC_DATA_H
+
+#include "tracking-analyzer/bounding_box.h"
+#include <cstdint>
+#include <string>
+
+namespace analyzer
+{
+  /// The size of a synthetic dataset and its tracking results.
+  struct synthetic_options final
+  {
+    /// The number of sequences in the dataset.
+    int sequence_count {100};
+
+    /// The shortest sequence, in frames.
+    int minimum_frame_count {100};
+
+    /// The longest sequence, in frames. Sequence lengths are spread evenly
+    /// between the minimum and maximum.
+    int maximum_frame_count {1000};
+
+    /// The number of trackers to write results for.
+    int tracker_count {10};
+
+    /// The width of the frames, in pixels. Targets stay inside the frames.
+    int frame_width {640};
+
+    /// The height of the frames, in pixels.
+    int frame_height {480};
+
+    /// Every random choice comes from this seed, so the same options always
+    /// make the same data.
+    std::uint32_t seed {0};
+
+    /// The number of threads that write files. Zero means use
+    /// default_worker_count().
+    unsigned int worker_count {0};
+  };
+
+  /**
+   * \brief Get the name of a synthetic sequence.
+   * \param[in] sequence The index of the sequence.
+   * \return The name, such as "sequence00042". Names sort in index order.
+   */
+  [[nodiscard]] auto synthetic_sequence_name(int sequence) -> std::string;
+
+  /**
+   * \brief Get the name of a synthetic tracker.
+   * \param[in] tracker The index of the tracker.
+   * \return The name, such as "tracker007". Names sort in index order.
+   */
+  [[nodiscard]] auto synthetic_tracker_name(int tracker) -> std::string;
+
+  /**
+   * \brief Make the ground truth for one synthetic sequence.
+   * \param[in] options The size of the dataset.
+   * \param[in] sequence The index of the sequence.
+   * \return One box for each frame. The target drifts around the frame with
+   *    a smoothly changing velocity and size, and bounces off the frame's
+   *    edges. Coordinates are whole pixels, like the OTB ground truth.
+   * \throws std::invalid_argument If \a options are invalid, or \a sequence
+   *    is not in [0, sequence_count).
+   */
+  [[nodiscard]] auto make_synthetic_ground_truth(
+    const synthetic_options& options,
+    int sequence) -> bounding_box_list;
+
+  /**
+   * \brief Make one tracker's results for one synthetic sequence.
+   * \param[in] options The size of the dataset.
+   * \param[in] ground_truth The ground truth of the sequence.
+   * \param[in] tracker The index of the tracker.
+   * \param[in] sequence The index of the sequence.
+   * \return One box for each ground truth box. The first box is the ground
+   *    truth, as if the tracker were initialized with it. After that, the
+   *    boxes wander around the target; each tracker has its own accuracy,
+   *    and now and then loses the target and slowly recovers.
+   * \throws std::invalid_argument If \a options are invalid, or \a tracker is
+   *    not in [0, tracker_count).
+   */
+  [[nodiscard]] auto
+  make_synthetic_results(const synthetic_options& options,
+                         const bounding_box_list& ground_truth,
+                         int tracker,
+                         int sequence) -> bounding_box_list;
+
+  /**
+   * \brief Write a synthetic dataset in the OTB layout.
+   * \param[in] path The dataset directory. It's created if it doesn't exist.
+   * \param[in] options The size of the dataset.
+   * \throws std::invalid_argument If \a options are invalid.
+   * \throws std::runtime_error If a file cannot be written.
+   * \details Each sequence directory has an img/ directory with a file for
+   * each frame, groundtruth_rect.txt, and attrs.txt with a random set of OTB
+   * attributes. The frame files are empty: the analyzer only lists them until
+   * a frame is displayed, and empty files keep a dataset of millions of frames
+   * small.
+   */
+  void write_synthetic_dataset(const std::string& path,
+                               const synthetic_options& options);
+
+  /**
+   * \brief Write synthetic tracking results for the dataset that
+   *    write_synthetic_dataset() writes with the same options.
+   * \param[in] path The results directory. It's created if it doesn't exist.
+   * \param[in] options The size of the dataset and the number of trackers.
+   * \throws std::invalid_argument If \a options are invalid.
+   * \throws std::runtime_error If a file cannot be written.
+   * \details The layout is the one load_tracking_results_directory() reads:
+   * a directory for each tracker, with a text file for each sequence.
+   */
+  void write_synthetic_results(const std::string& path,
+                               const synthetic_options& options);
+}  // namespace analyzer
+
+#endif
@@ -1,15 +1,46 @@
 #include "tracking-analyzer/tracking_results.h"
 #include "tracking-analyzer/filesystem.h"
+#include "tracking-analyzer/parallel.h"
+#include "tracking-analyzer/results_cache.h"
 #include <QDir>
-#include <QJsonArray>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <fstream>
+#include <algorithm>
+#include <gsl/gsl_util>
+#include <optional>
 
 namespace analyzer
 {
   using namespace std::literals::string_literals;
 
+  namespace
+  {
+    // Map each name to the index of the first element with that name, the
+    // same element a linear search would find.
+    template <typename List>
+    [[nodiscard]] auto make_name_index(const List& list)
+    {
+      name_index index;
+      index.reserve(list.size());
+      for (typename List::size_type i {0}; i < list.size(); ++i)
+      {
+        index.emplace(list[i].name(), i);
+      }
+      return index;
+    }
+
+    // The owners reset their index whenever their list can change, so a miss
+    // means there's no element with the name.
+    [[nodiscard]] auto find_by_name(const name_index& index,
+                                    const std::string& name)
+      -> std::optional<std::size_t>
+    {
+      if (const auto i {index.find(name)}; i != std::end(index))
+      {
+        return i->second;
+      }
+      return std::nullopt;
+    }
+  }  // namespace
+
   sequence_results::sequence_results(
     const std::string& sequence_name,
     const bounding_box_list& target_bounding_boxes):
@@ -17,7 +48,10 @@ namespace analyzer
   {
   }
 
-  auto sequence_results::name() const -> std::string { return m_name; }
+  auto sequence_results::name() const noexcept -> const std::string&
+  {
+    return m_name;
+  }
 
   auto sequence_results::bounding_boxes() const noexcept
     -> const bounding_box_list&
@@ -27,9 +61,30 @@ namespace analyzer
 
   auto sequence_results::bounding_boxes() noexcept -> bounding_box_list&
   {
+    m_metrics.reset();
     return m_target_boxes;
   }
 
+  auto sequence_results::box_columns() const -> box_array
+  {
+    return box_array {m_target_boxes};
+  }
+
+  auto sequence_results::metrics(const box_array& ground_truth) const
+    -> const frame_metrics&
+  {
+    return m_metrics.get([this, &ground_truth]() {
+      const auto boxes {box_columns()};
+      return frame_metrics {calculate_overlaps(boxes, ground_truth),
+                            calculate_offsets(boxes, ground_truth)};
+    });
+  }
+
+  void sequence_results::reset_metrics() noexcept
+  {
+    m_metrics.reset();
+  }
+
   auto sequence_results::operator[](bounding_box_list::size_type i) const
     -> const bounding_box&
   {
@@ -39,6 +94,7 @@ namespace analyzer
   auto sequence_results::operator[](bounding_box_list::size_type i)
     -> bounding_box&
   {
+    m_metrics.reset();
     return m_target_boxes.at(i);
   }
 
@@ -66,7 +122,10 @@ namespace analyzer
   {
   }
 
-  auto tracker_results::name() const -> std::string { return m_name; }
+  auto tracker_results::name() const noexcept -> const std::string&
+  {
+    return m_name;
+  }
 
   auto tracker_results::sequences() const noexcept -> const sequence_list&
   {
@@ -75,6 +134,7 @@ namespace analyzer
 
   auto tracker_results::sequences() noexcept -> sequence_list&
   {
+    m_index.reset();
     return m_sequences;
   }
 
@@ -86,53 +146,54 @@ namespace analyzer
 
   auto tracker_results::operator[](const size_type i) -> sequence_results&
   {
+    // The caller can replace the sequence results, and its name with them.
+    m_index.reset();
     return m_sequences.at(i);
   }
 
-  auto tracker_results::operator[](const std::string& sequence_name) const
-    -> const sequence_results&
+  auto tracker_results::find(const std::string& sequence_name) const
+    -> std::optional<size_type>
+  {
+    return find_by_name(
+      m_index.get([this]() { return make_name_index(m_sequences); }),
+      sequence_name);
+  }
+
+  auto tracker_results::index_of(const std::string& sequence_name) const
+    -> size_type
   {
-    const auto i {
-      std::find_if(std::begin(m_sequences),
-                   std::end(m_sequences),
-                   [&sequence_name](const sequence_results& results) {
-                     return results.name() == sequence_name;
-                   })};
-    if (i == std::end(m_sequences))
+    if (const auto i {find(sequence_name)})
     {
-      throw invalid_sequence {
-        sequence_name,
-        "",
-        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
-        "sequence not found in "s
-          + m_name
-          // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
-          + " tracking results"s};
+      return *i;
     }
-    return *i;
+    throw invalid_sequence {
+      sequence_name,
+      "",
+      // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+      "sequence not found in "s
+        + m_name
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+        + " tracking results"s};
+  }
+
+  auto tracker_results::operator[](const std::string& sequence_name) const
+    -> const sequence_results&
+  {
+    return m_sequences[index_of(sequence_name)];
   }
 
   auto tracker_results::operator[](const std::string& sequence_name)
     -> sequence_results&
   {
-    const auto i {
-      std::find_if(std::begin(m_sequences),
-                   std::end(m_sequences),
-                   [&sequence_name](const sequence_results& results) {
-                     return results.name() == sequence_name;
-                   })};
-    if (i == std::end(m_sequences))
+    return (*this)[index_of(sequence_name)];
+  }
+
+  void tracker_results::reset_metrics() noexcept
+  {
+    for (auto& sequence : m_sequences)
     {
-      throw invalid_sequence {
-        sequence_name,
-        "",
-        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
-        "sequence not found in "s
-          + m_name
-          // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
-          + " tracking results"s};
+      sequence.reset_metrics();
     }
-    return *i;
   }
 
   auto size(const tracker_results& tracker) noexcept
@@ -160,43 +221,62 @@ namespace analyzer
 
   auto results_database::trackers() noexcept -> tracker_list&
   {
+    m_index.reset();
     return m_trackers;
   }
 
-  auto results_database::operator[](const std::string& tracker_name) const
-    -> const tracker_results&
+  auto results_database::find(const std::string& tracker_name) const
+    -> std::optional<size_type>
+  {
+    return find_by_name(
+      m_index.get([this]() { return make_name_index(m_trackers); }),
+      tracker_name);
+  }
+
+  auto results_database::index_of(const std::string& tracker_name) const
+    -> size_type
   {
-    const auto i {std::find_if(std::begin(m_trackers),
-                               std::end(m_trackers),
-                               [&tracker_name](const tracker_results& results) {
-                                 return results.name() == tracker_name;
-                               })};
-    if (i == std::end(m_trackers))
+    if (const auto i {find(tracker_name)})
     {
-      throw invalid_tracker {
-        tracker_name,
-        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
-        tracker_name + " not found in results database"s};
+      return *i;
     }
-    return *i;
+    throw invalid_tracker {
+      tracker_name,
+      // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+      tracker_name + " not found in results database"s};
+  }
+
+  auto results_database::operator[](const size_type i) const
+    -> const tracker_results&
+  {
+    return m_trackers.at(i);
+  }
+
+  auto results_database::operator[](const size_type i) -> tracker_results&
+  {
+    // The caller can replace the tracker results, and its name with them.
+    m_index.reset();
+    return m_trackers.at(i);
+  }
+
+  auto results_database::operator[](const std::string& tracker_name) const
+    -> const tracker_results&
+  {
+    return m_trackers[index_of(tracker_name)];
   }
 
   auto results_database::operator[](const std::string& tracker_name)
     -> tracker_results&
   {
-    const auto i {std::find_if(std::begin(m_trackers),
-                               std::end(m_trackers),
-                               [&tracker_name](const tracker_results& results) {
-                                 return results.name() == tracker_name;
-                               })};
-    if (i == std::end(m_trackers))
+    return (*this)[index_of(tracker_name)];
+  }
+
+  void results_database::reset_metrics() noexcept
+  {
+    for (auto& tracker : m_trackers)
     {
-      throw invalid_tracker {
-        tracker_name,
-        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
-        tracker_name + " not found in results database"s};
+      tracker.reset_metrics();
     }
-    return *i;
   }
 
   auto size(const results_database& db) noexcept -> results_database::size_type
@@ -228,41 +308,6 @@ namespace analyzer
 
   namespace
   {
-    [[nodiscard]] auto read_result_lines(const QString& filepath)
-    {
-      QStringList lines;
-      std::string one_line;
-      std::ifstream file {filepath.toStdString()};
-      while (file)
-      {
-        file >> one_line;
-        if (!one_line.empty())
-        {
-          lines.append(QString::fromStdString(one_line));
-        }
-      }
-      return lines;
-    }
-
-    [[nodiscard]] auto parse_line(const QString& line)
-    {
-      const auto numbers {line.split(",")};
-      return bounding_box {numbers.at(0).toFloat(),
-                           numbers.at(1).toFloat(),
-                           numbers.at(2).toFloat(),
-                           numbers.at(3).toFloat()};
-    }
-
-    [[nodiscard]] auto parse_lines(const QStringList& lines)
-    {
-      std::vector<bounding_box> boxes;
-      std::transform(std::begin(lines),
-                     std::end(lines),
-                     std::back_insert_iterator {boxes},
-                     &parse_line);
-      return boxes;
-    }
-
     [[nodiscard]] auto get_sequence_file_paths(const QString& path)
     {
       const QDir directory {path};
@@ -277,44 +322,219 @@ namespace analyzer
       return sequences;
     }
 
+    [[nodiscard]] auto sequence_name(const QString& path)
+    {
+      return analyzer::basename(path).replace(".txt", "").toStdString();
+    }
+
     [[nodiscard]] auto load_tracking_results_for_sequence(const QString& path)
     {
-      const auto lines {read_result_lines(make_absolute_path(path))};
-      return sequence_results {
-        analyzer::basename(path).replace(".txt", "").toStdString(),
-        parse_lines(lines)};
+      return sequence_results {sequence_name(path),
+                               analyzer::read_bounding_box_file(
+                                 make_absolute_path(path).toStdString())};
+    }
+
+    /// One sequence file to load, and the tracker it belongs to.
+    struct sequence_task final
+    {
+      results_database::size_type tracker {0};
+      QString path;
+      sequence_results results;
+      std::string error;
+
+      /// The path relative to the results directory, like "MDNet/Deer.txt".
+      std::string source;
+      file_stamp stamp;
+      bool from_cache {false};
+    };
+
+    [[nodiscard]] auto make_sequence_tasks(const QString& root_path,
+                                           const QStringList& trackers,
+                                           const unsigned int worker_count)
+    {
+      // Listing a directory is a blocking filesystem call, too, so list the
+      // tracker directories in parallel before fanning out over the files.
+      std::vector<QStringList> sequence_files(
+        gsl::narrow_cast<std::vector<QStringList>::size_type>(trackers.size()));
+      analyzer::parallel_for(
+        sequence_files.size(),
+        worker_count,
+        [&root_path, &trackers, &sequence_files](const std::size_t i) {
+          sequence_files[i] = get_sequence_file_paths(
+            root_path + '/' + trackers[gsl::narrow_cast<int>(i)]);
+        });
+      std::vector<sequence_task> tasks;
+      for (std::size_t t {0}; t < sequence_files.size(); ++t)
+      {
+        for (const auto& file : sequence_files[t])
+        {
+          const auto source {trackers[gsl::narrow_cast<int>(t)] + '/' + file};
+          tasks.push_back(sequence_task {t,
+                                         root_path + '/' + source,
+                                         {},
+                                         {},
+                                         source.toStdString(),
+                                         {},
+                                         false});
+        }
+      }
+      return tasks;
+    }
+
+    // Load each task's sequence file. If a cache is supplied, take the boxes
+    // from the cache for files that haven't changed since it was written.
+    void run_sequence_tasks(std::vector<sequence_task>& tasks,
+                            const unsigned int worker_count,
+                            const results_cache* const cache)
+    {
+      analyzer::parallel_for(
+        tasks.size(), worker_count, [&tasks, cache](const std::size_t i) {
+          auto& task {tasks[i]};
+          try
+          {
+            if (cache != nullptr)
+            {
+              // Stamp the file before reading it. If the file changes while
+              // it's read, the next load sees a new stamp and reads it again.
+              task.stamp = analyzer::stamp_file(task.path.toStdString());
+              if (auto boxes {cache->find(task.source, task.stamp)})
+              {
+                task.results
+                  = sequence_results {sequence_name(task.path), *boxes};
+                task.from_cache = true;
+                return;
+              }
+            }
+            task.results = load_tracking_results_for_sequence(task.path);
+          }
+          catch (const std::exception& e)
+          {
+            task.error = e.what();
+          }
+        });
     }
 
-    [[nodiscard]] auto
-    load_tracking_results_for_tracker(const QString& path,
-                                      const QString& tracker_name)
+    // The cache must be rewritten if any file was read from its source, or
+    // the cache has records for files that no longer exist.
+    [[nodiscard]] auto is_cache_stale(const std::vector<sequence_task>& tasks,
+                                      const results_cache& cache)
     {
-      const auto sequences {get_sequence_file_paths(path + '/' + tracker_name)};
-      tracker_results r {tracker_name.toStdString(), {}};
-      std::transform(std::begin(sequences),
-                     std::end(sequences),
-                     std::back_inserter(r.sequences()),
-                     [&path, &tracker_name](const QString& sequence) {
-                       return load_tracking_results_for_sequence(
-                         path + '/' + tracker_name + '/' + sequence);
-                     });
-      return r;
+      std::size_t cached {0};
+      for (const auto& task : tasks)
+      {
+        if (task.error.empty() && !task.from_cache)
+        {
+          return true;
+        }
+        if (task.from_cache)
+        {
+          ++cached;
+        }
+      }
+      return cached != cache.size();
+    }
+
+    [[nodiscard]] auto update_cache(const std::string& cache_path,
+                                    const std::vector<sequence_task>& tasks)
+      -> std::optional<load_error>
+    {
+      std::vector<cache_record> records;
+      records.reserve(tasks.size());
+      for (const auto& task : tasks)
+      {
+        if (task.error.empty())
+        {
+          records.push_back(cache_record {
+            task.source, task.stamp, task.results.bounding_boxes()});
+        }
+      }
+      try
+      {
+        analyzer::write_results_cache(cache_path, records);
+      }
+      catch (const std::runtime_error& e)
+      {
+        // The results loaded fine, so report the cache problem but keep them.
+        return load_error {cache_path, e.what()};
+      }
+      return std::nullopt;
+    }
+
+    // The tasks are already in tracker order, then sequence order, so a
+    // single pass assembles the database the same way regardless of which
+    // thread finished first.
+    [[nodiscard]] auto assemble_database(const QStringList& trackers,
+                                         std::vector<sequence_task>& tasks,
+                                         load_error_list& errors)
+    {
+      results_database db;
+      db.trackers().reserve(
+        gsl::narrow_cast<results_database::size_type>(trackers.size()));
+      for (const auto& tracker : trackers)
+      {
+        db.trackers().emplace_back(tracker.toStdString(),
+                                   tracker_results::sequence_list {});
+      }
+      for (auto& task : tasks)
+      {
+        if (task.error.empty())
+        {
+          db.trackers()[task.tracker].sequences().push_back(
+            std::move(task.results));
+        }
+        else
+        {
+          errors.push_back(
+            load_error {task.path.toStdString(), std::move(task.error)});
+        }
+      }
+      return db;
     }
   }  // namespace
 
   auto load_tracking_results_directory(const std::string& path)
     -> results_database
+  {
+    load_error_list errors;
+    return analyzer::load_tracking_results_directory(path, 0, errors);
+  }
+
+  auto load_tracking_results_directory(const std::string& path,
+                                       const unsigned int worker_count,
+                                       load_error_list& errors)
+    -> results_database
+  {
+    const auto root_path {QString::fromStdString(path)};
+    const auto trackers {analyzer::get_subdirectories(path)};
+    auto tasks {make_sequence_tasks(root_path, trackers, worker_count)};
+    run_sequence_tasks(tasks, worker_count, nullptr);
+    return assemble_database(trackers, tasks, errors);
+  }
+
+  auto load_tracking_results_directory(const std::string& path,
+                                       const std::string& cache_path,
+                                       const unsigned int worker_count,
+                                       load_error_list& errors)
+    -> results_database
   {
     const auto root_path {QString::fromStdString(path)};
     const auto trackers {analyzer::get_subdirectories(path)};
-    results_database db;
-    std::transform(std::begin(trackers),
-                   std::end(trackers),
-                   std::back_inserter(db.trackers()),
-                   [&root_path](const QString& tracker) {
-                     return load_tracking_results_for_tracker(root_path,
-                                                              tracker);
-                   });
+    auto tasks {make_sequence_tasks(root_path, trackers, worker_count)};
+    {
+      // Unmap the old cache before writing the new one.
+      const results_cache cache {cache_path};
+      run_sequence_tasks(tasks, worker_count, &cache);
+      if (!is_cache_stale(tasks, cache))
+      {
+        return assemble_database(trackers, tasks, errors);
+      }
+    }
+    const auto cache_error {update_cache(cache_path, tasks)};
+    auto db {assemble_database(trackers, tasks, errors)};
+    if (cache_error)
+    {
+      errors.push_back(*cache_error);
+    }
     return db;
   }
 }  // namespace analyzer
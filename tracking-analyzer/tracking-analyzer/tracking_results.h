@@ -2,15 +2,36 @@
 #define ANALYZER_TRACKING_RESULTS_H
 
 #include "tracking-analyzer/bounding_box.h"
+#include "tracking-analyzer/box_array.h"
 #include "tracking-analyzer/exceptions.h"
+#include "tracking-analyzer/lazy.h"
 #include <QList>
 #include <QString>
 #include <array>
+#include <optional>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace analyzer
 {
+  /// Map names to indices in a list of results, for fast lookup by name.
+  using name_index = std::unordered_map<std::string, std::size_t>;
+
+  /**
+   * \brief The per-frame accuracy of tracking results against ground truth.
+   * \details Element \a i of each list describes frame \a i of the sequence.
+   */
+  struct frame_metrics final
+  {
+    /// The overlap of each tracked box with its ground truth box.
+    overlap_list overlaps;
+
+    /// The distance between the center of each tracked box and the center of
+    /// its ground truth box, in pixels.
+    offset_list offsets;
+  };
+
   /**
    * \brief Encapsulate tracking results for one sequence.
    * \details The sequence_results class collects together the results for one
@@ -43,15 +64,49 @@ namespace analyzer
                      const bounding_box_list& target_bounding_boxes);
 
     /// \brief Get the name of the sequence.
-    [[nodiscard]] auto name() const -> std::string;
+    [[nodiscard]] auto name() const noexcept -> const std::string&;
 
     /// \brief Get read-only access to the sequence's target bounding boxes.
     [[nodiscard]] auto bounding_boxes() const noexcept
       -> const bounding_box_list&;
 
-    /// \brief Get read-write access to the sequences target bounding boxes.
+    /**
+     * \brief Get read-write access to the sequences target bounding boxes.
+     * \details This throws away the cached metrics. Don't keep the reference
+     * across a call to metrics(); the metrics wouldn't see later changes.
+     */
     [[nodiscard]] auto bounding_boxes() noexcept -> bounding_box_list&;
 
+    /**
+     * \brief Get the target bounding boxes as a structure of arrays.
+     * \return A copy of the boxes in bounding_boxes().
+     * \details The box array is built on every call, so it's never out of
+     * date, and spans into it stay valid however the boxes change. This
+     * function is safe to call from multiple threads at once.
+     */
+    [[nodiscard]] auto box_columns() const -> box_array;
+
+    /**
+     * \brief Get the per-frame overlaps and offsets against ground truth.
+     * \param[in] ground_truth The ground truth boxes for the sequence, from
+     *    the benchmark dataset.
+     * \return A read-only reference to the metrics.
+     * \throws std::invalid_argument If \a ground_truth doesn't have the same
+     *    number of boxes as this sequence_results.
+     * \details The metrics are calculated the first time they're requested,
+     * then kept until the boxes are accessed through a read-write function or
+     * reset_metrics() is called. The cache doesn't know which ground truth the
+     * metrics came from, so call reset_metrics() if the ground truth changes,
+     * for example when the dataset is loaded again. This function is safe to
+     * call from multiple threads at once.
+     */
+    [[nodiscard]] auto metrics(const box_array& ground_truth) const
+      -> const frame_metrics&;
+
+    /// Throw away the cached metrics, so the next call to metrics()
+    /// calculates them again.
+    void reset_metrics() noexcept;
+
     /**
      * \brief Get read-only access to a specific target bounding box.
      * \param[in] i The index into the bounding box list. This is not a frame
@@ -77,6 +132,7 @@ namespace analyzer
   private:
     std::string m_name;
     bounding_box_list m_target_boxes;
+    lazy<frame_metrics> m_metrics;
   };
 
   /**
@@ -151,7 +207,7 @@ namespace analyzer
                     const sequence_list& tracked_sequences);
 
     /// Get the name of the tracker.
-    [[nodiscard]] auto name() const -> std::string;
+    [[nodiscard]] auto name() const noexcept -> const std::string&;
 
     /// Get read-only access to the set of sequence results.
     [[nodiscard]] auto sequences() const noexcept -> const sequence_list&;
@@ -159,6 +215,37 @@ namespace analyzer
     /// Get read-write access to the set of sequence results.
     [[nodiscard]] auto sequences() noexcept -> sequence_list&;
 
+    /**
+     * \brief Find the index of the results for a specific sequence.
+     * \param[in] sequence_name The name of the sequence results to find. This
+     *    is case sensitive.
+     * \return The index of the first sequence results named \a
+     *    sequence_name, or std::nullopt if there are none.
+     * \details Lookups use a hash index of the sequence names, so a lookup
+     * takes constant time, whether or not it finds the name. The index is
+     * built on the first lookup, and rebuilt after any read-write access to
+     * the sequences, through sequences() or a non-const operator[]. Don't
+     * keep a read-write reference across a lookup; changes made through it
+     * later aren't seen by the index. Code that looks up the same sequence
+     * repeatedly, such as once per video frame, should look up the index once
+     * and then use operator[](size_type).
+     */
+    [[nodiscard]] auto find(const std::string& sequence_name) const
+      -> std::optional<size_type>;
+
+    /**
+     * \brief Get the index of the results for a specific sequence.
+     * \param[in] sequence_name The name of the sequence results to find. This
+     *    is case sensitive.
+     * \return The index of the first sequence results named \a
+     *    sequence_name.
+     * \throws invalid_sequence If no sequence exist with name equal to \a
+     *    sequence_name.
+     * \see find()
+     */
+    [[nodiscard]] auto index_of(const std::string& sequence_name) const
+      -> size_type;
+
     /**
      * \brief Get read-only access to the results for a specific sequence.
      * \param[in] i The index into the sequence results list. This is a
@@ -199,9 +286,14 @@ namespace analyzer
     [[nodiscard]] auto operator[](const std::string& sequence_name)
       -> sequence_results&;
 
+    /// Throw away the cached metrics of every sequence results.
+    /// \see sequence_results::reset_metrics()
+    void reset_metrics() noexcept;
+
   private:
     std::string m_name;
     sequence_list m_sequences;
+    lazy<name_index> m_index;
   };
 
   /**
@@ -268,6 +360,52 @@ namespace analyzer
     /// Get read-write access to the list of tracker results.
     [[nodiscard]] auto trackers() noexcept -> tracker_list&;
 
+    /**
+     * \brief Find the index of the results for a specific tracker.
+     * \param[in] tracker_name The name of the tracker results to find. This is
+     *    case sensitive.
+     * \return The index of the first tracker results named \a tracker_name, or
+     *    std::nullopt if there are none.
+     * \details Lookups use a hash index of the tracker names, so a lookup
+     * takes constant time, whether or not it finds the name. The index is
+     * built on the first lookup, and rebuilt after any read-write access to
+     * the trackers, through trackers() or a non-const operator[]. Don't keep
+     * a read-write reference across a lookup; changes made through it later
+     * aren't seen by the index. Code that looks up the same tracker
+     * repeatedly should look up the index once and then use
+     * operator[](size_type).
+     */
+    [[nodiscard]] auto find(const std::string& tracker_name) const
+      -> std::optional<size_type>;
+
+    /**
+     * \brief Get the index of the results for a specific tracker.
+     * \param[in] tracker_name The name of the tracker results to find. This is
+     *    case sensitive.
+     * \return The index of the first tracker results named \a tracker_name.
+     * \throws invalid_tracker If no tracker exist with name equal to \a
+     *    tracker_name.
+     * \see find()
+     */
+    [[nodiscard]] auto index_of(const std::string& tracker_name) const
+      -> size_type;
+
+    /**
+     * \brief Get read-only access to the results for a specific tracker.
+     * \param[in] i The index into the tracker results list.
+     * \return A read-only reference to the requested tracker results.
+     * \throws std::out_of_range If \$i \ge size()\$.
+     */
+    [[nodiscard]] auto operator[](size_type i) const -> const tracker_results&;
+
+    /**
+     * \brief Get read-write access to the results for a specific tracker.
+     * \param[in] i The index into the tracker results list.
+     * \return A read-write reference to the requested tracker results.
+     * \throws std::out_of_range If \$i \ge size()\$.
+     */
+    [[nodiscard]] auto operator[](size_type i) -> tracker_results&;
+
     /**
      * \brief Get read-only access to the results for a specific tracker.
      * \param[in] tracker_name The name of the tracker results to get. This is
@@ -290,8 +428,17 @@ namespace analyzer
     [[nodiscard]] auto operator[](const std::string& tracker_name)
       -> tracker_results&;
 
+    /**
+     * \brief Throw away the cached metrics of every tracker.
+     * \details Call this when the dataset that the results are measured
+     * against is loaded again.
+     * \see sequence_results::reset_metrics()
+     */
+    void reset_metrics() noexcept;
+
   private:
     tracker_list m_trackers;
+    lazy<name_index> m_index;
   };
 
   /**
@@ -365,9 +512,60 @@ namespace analyzer
    * \endverbatim
    * This example includes two trackers: MDNet and VITAL. Each tracker contains
    * results for two sequences: Basketball and Deer.
+   *
+   * Sequence files that cannot be loaded are left out of the database. Use
+   * the overload that takes a load_error_list to find out which files were
+   * skipped.
    */
   [[nodiscard]] auto load_tracking_results_directory(const std::string& path)
     -> results_database;
+
+  /**
+   * \brief Load results for all trackers found in a directory on disk, using
+   *    multiple threads.
+   * \param[in] path The path to the directory to search for tracking results.
+   * \param[in] worker_count The number of threads to use. Zero means use
+   *    default_worker_count().
+   * \param[out] errors Each sequence file that could not be loaded is appended
+   *    to this list. The list is in the same order as the database.
+   * \return A results_database with the tracking results found in \a path.
+   * \details The directory layout is the same as for
+   * load_tracking_results_directory(const std::string&). All the sequence files
+   * for all the trackers go into one pool of work, so a tracker with many
+   * sequences doesn't hold up the others. Regardless of the number of threads,
+   * trackers and sequences in the database are sorted by name. A sequence file
+   * that fails to load does not abort the load; it's reported in \a errors
+   * and left out of its tracker's results.
+   */
+  [[nodiscard]] auto load_tracking_results_directory(const std::string& path,
+                                                     unsigned int worker_count,
+                                                     load_error_list& errors)
+    -> results_database;
+
+  /**
+   * \brief Load results for all trackers found in a directory on disk, reusing
+   *    a binary cache of previously loaded results.
+   * \param[in] path The path to the directory to search for tracking results.
+   * \param[in] cache_path The path to the cache file for \a path. The file
+   *    doesn't have to exist.
+   * \param[in] worker_count The number of threads to use. Zero means use
+   *    default_worker_count().
+   * \param[out] errors Each sequence file that could not be loaded is appended
+   *    to this list. If the cache could not be updated, that's appended last.
+   * \return A results_database with the tracking results found in \a path.
+   * \details This is the same as
+   * load_tracking_results_directory(const std::string&, unsigned int,
+   * load_error_list&), except sequence files that haven't changed since the
+   * cache was written are copied from the cache instead of parsed. A file is
+   * unchanged if its size and modification time match the cache. If any file
+   * had to be parsed, or files were removed, the cache file is rewritten.
+   * \see results_cache
+   */
+  [[nodiscard]] auto load_tracking_results_directory(
+    const std::string& path,
+    const std::string& cache_path,
+    unsigned int worker_count,
+    load_error_list& errors) -> results_database;
 }  // namespace analyzer
 
 #endif
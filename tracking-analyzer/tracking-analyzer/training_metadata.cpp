@@ -1,183 +1,714 @@
 #include "tracking-analyzer/training_metadata.h"
 #include "tracking-analyzer/filesystem.h"
 #include <QFile>
-#include <QJsonArray>
-#include <QJsonDocument>
-#include <QJsonObject>
 #include <algorithm>
+#include <array>
 #include <gsl/gsl_util>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__)
+#  define ANALYZER_X86_KERNELS
+#  include <emmintrin.h>
+#endif
 
 namespace analyzer
 {
   namespace
   {
-    auto parse_training_score_update_frames(const QJsonObject& score_json)
+    // Read the file in chunks of this many bytes.
+    constexpr qint64 chunk_size {64 * 1024};
+
+    // Nesting deeper than this in parts of the file that are skipped is
+    // treated as corrupt, rather than risking the stack.
+    constexpr int maximum_skip_depth {256};
+
+    /*
+     * Read JSON tokens from a file, one chunk at a time, so memory use doesn't
+     * depend on the size of the file. The training score parser pulls exactly
+     * the values it needs, and writes scores straight into their lists; no
+     * document tree is built.
+     */
+    class json_reader final
     {
-      std::vector<int> update_frames;
-      const auto keys {score_json.keys()};
-      std::transform(std::begin(keys),
-                     std::end(keys),
-                     std::back_insert_iterator {update_frames},
-                     [](const QString& key) { return key.toInt(); });
-      return update_frames;
+    public:
+      // The file must be positioned at offset, which is only used for error
+      // messages.
+      explicit json_reader(QFile& file, const qint64 offset = 0):
+        m_file {file}, m_offset {offset}
+      {
+      }
+
+      // Get the number of bytes of the file consumed so far.
+      [[nodiscard]] auto offset() const noexcept -> qint64 { return m_offset; }
+
+      // Get the next character, after any whitespace, without consuming it.
+      // At the end of the file, get '\0'.
+      [[nodiscard]] auto peek() -> char
+      {
+        skip_whitespace();
+        return at_end() ? '\0' : m_buffer.at(m_position);
+      }
+
+      void expect(const char c)
+      {
+        if (peek() != c)
+        {
+          fail(std::string {"expected '"} + c + "'");
+        }
+        static_cast<void>(get());
+      }
+
+      // Consume the next character if it's c.
+      [[nodiscard]] auto accept(const char c) -> bool
+      {
+        if (peek() != c)
+        {
+          return false;
+        }
+        static_cast<void>(get());
+        return true;
+      }
+
+      // Read a string, and get it as UTF-8.
+      [[nodiscard]] auto read_string() -> QByteArray
+      {
+        expect('"');
+        QByteArray string;
+        for (auto c {get()}; c != '"'; c = get())
+        {
+          if (c == '\\')
+          {
+            read_escape(string);
+          }
+          else if (static_cast<unsigned char>(c) < 0x20)
+          {
+            fail("control character in a string");
+          }
+          else
+          {
+            string.append(c);
+          }
+        }
+        return string;
+      }
+
+      [[nodiscard]] auto read_number() -> double
+      {
+        if (peek() == '\0')
+        {
+          fail("expected a number");
+        }
+        QByteArray token;
+        while (!at_end() && is_number_character(m_buffer.at(m_position)))
+        {
+          token.append(get());
+        }
+        bool ok {false};
+        const auto number {token.toDouble(&ok)};
+        if (!ok)
+        {
+          fail("expected a number");
+        }
+        return number;
+      }
+
+      void skip_value(const int depth = 0);
+
+      [[noreturn]] void fail(const std::string& what) const
+      {
+        throw analyzer::parse_error {"Invalid JSON at byte "
+                                     + std::to_string(m_offset) + ": " + what};
+      }
+
+    private:
+      [[nodiscard]] static auto is_number_character(const char c) noexcept
+        -> bool
+      {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.'
+               || c == 'e' || c == 'E';
+      }
+
+      [[nodiscard]] auto at_end() -> bool
+      {
+        if (m_position < m_buffer.size())
+        {
+          return false;
+        }
+        m_buffer = m_file.read(chunk_size);
+        m_position = 0;
+        return m_buffer.isEmpty();
+      }
+
+      [[nodiscard]] auto get() -> char
+      {
+        if (at_end())
+        {
+          fail("unexpected end of file");
+        }
+        ++m_offset;
+        return m_buffer.at(m_position++);
+      }
+
+      void skip_whitespace()
+      {
+        while (!at_end())
+        {
+          const auto c {m_buffer.at(m_position)};
+          if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+          {
+            return;
+          }
+          static_cast<void>(get());
+        }
+      }
+
+      [[nodiscard]] auto read_code_unit() -> char16_t
+      {
+        QByteArray hex;
+        for (int i {0}; i < 4; ++i)
+        {
+          hex.append(get());
+        }
+        bool ok {false};
+        const auto unit {hex.toUShort(&ok, 16)};
+        if (!ok)
+        {
+          fail("invalid \\u escape");
+        }
+        return unit;
+      }
+
+      void read_escape(QByteArray& string)
+      {
+        switch (const auto c {get()}; c)
+        {
+        case '"':
+        case '\\':
+        case '/':
+          string.append(c);
+          break;
+        case 'b':
+          string.append('\b');
+          break;
+        case 'f':
+          string.append('\f');
+          break;
+        case 'n':
+          string.append('\n');
+          break;
+        case 'r':
+          string.append('\r');
+          break;
+        case 't':
+          string.append('\t');
+          break;
+        case 'u':
+        {
+          QString code_point {QChar {read_code_unit()}};
+          if (code_point.front().isHighSurrogate() && accept('\\'))
+          {
+            if (get() != 'u')
+            {
+              fail("expected a low surrogate");
+            }
+            code_point.append(QChar {read_code_unit()});
+          }
+          string.append(code_point.toUtf8());
+          break;
+        }
+        default:
+          fail(std::string {"invalid escape \\"} + c);
+        }
+      }
+
+      QFile& m_file;
+      QByteArray m_buffer;
+      int m_position {0};
+      qint64 m_offset {0};
+    };
+
+    // Call read_member(key) for each member of an object. read_member must
+    // consume the member's value.
+    template <typename MemberReader>
+    void read_object(json_reader& reader, MemberReader&& read_member)
+    {
+      reader.expect('{');
+      if (reader.accept('}'))
+      {
+        return;
+      }
+      do
+      {
+        const auto key {reader.read_string()};
+        reader.expect(':');
+        read_member(key);
+      } while (reader.accept(','));
+      reader.expect('}');
     }
 
-    auto read_json_data(const QString& filepath)
+    // Call read_element(index) for each element of an array. read_element
+    // must consume the element.
+    template <typename ElementReader>
+    void read_array(json_reader& reader, ElementReader&& read_element)
     {
-      QFile file {filepath};
-      if (!file.open(QIODevice::ReadOnly))
+      reader.expect('[');
+      if (reader.accept(']'))
       {
-        throw std::runtime_error {"cannot open file"};
+        return;
       }
-      return QJsonDocument::fromJson(file.readAll()).object();
-    }
-
-    auto get_chart_range(const score_list& scores)
-    {
-      if (scores.empty())
-      {
-        // TODO Change this to something better.
-        return range {0.0f, 0.0f};
-      }
-      const auto minimum_x {
-        std::min_element(
-          std::begin(scores),
-          std::end(scores),
-          [](const QPointF& a, const QPointF& b) { return a.x() < b.x(); })
-          ->x()};
-      const auto maximum_x {
-        std::max_element(
-          std::begin(scores),
-          std::end(scores),
-          [](const QPointF& a, const QPointF& b) { return a.x() < b.x(); })
-          ->x()};
-      const auto minimum_y {
-        std::min_element(
-          std::begin(scores),
-          std::end(scores),
-          [](const QPointF& a, const QPointF& b) { return a.y() < b.y(); })
-          ->y()};
-      const auto maximum_y {
-        std::max_element(
-          std::begin(scores),
-          std::end(scores),
-          [](const QPointF& a, const QPointF& b) { return a.y() < b.y(); })
-          ->y()};
-      return range {std::min(minimum_x, minimum_y),
-                    std::max(maximum_x, maximum_y)};
-    }
-
-    auto to_point(const QJsonValue& json)
-    {
-      // I'm not sure why, but something like QJsonArray a{json.toArray()};
-      // doesn't work. Subsequent a[0].toDouble() returns 0, regardless of what
-      // the actual value is.
-      return QPointF {json.toArray()[0].toDouble(),
-                      json.toArray()[1].toDouble()};
-    }
-
-    void fill_training_scores(const QJsonArray& json_data,
-                              QList<QPointF>& scores)
-    {
-      std::transform(std::begin(json_data),
-                     std::end(json_data),
-                     std::back_insert_iterator(scores),
-                     &to_point);
-    }
-
-    auto parse_training_batch(const QJsonObject& json)
-    {
-      training_batch batch;
-      fill_training_scores(json["background candidates"].toArray(),
-                           batch.background_candidates);
-      fill_training_scores(json["background mined"].toArray(),
-                           batch.background_mined);
-      fill_training_scores(json["target candidates"].toArray(),
-                           batch.target_candidates);
-      batch.background_threshold
-        = gsl::narrow_cast<float>(json["thresholds"].toArray()[0].toDouble());
-      batch.target_threshold
-        = gsl::narrow_cast<float>(json["thresholds"].toArray()[1].toDouble());
+      int index {0};
+      do
+      {
+        read_element(index);
+        ++index;
+      } while (reader.accept(','));
+      reader.expect(']');
+    }
+
+    void json_reader::skip_value(const int depth)
+    {
+      if (depth > maximum_skip_depth)
+      {
+        fail("nested too deeply");
+      }
+      switch (peek())
+      {
+      case '{':
+        read_object(*this, [this, depth](const QByteArray& /*unused*/) {
+          skip_value(depth + 1);
+        });
+        break;
+      case '[':
+        read_array(*this,
+                   [this, depth](int /*unused*/) { skip_value(depth + 1); });
+        break;
+      case '"':
+        static_cast<void>(read_string());
+        break;
+      case 't':
+      case 'f':
+      case 'n':
+      {
+        QByteArray literal;
+        while (!at_end() && m_buffer.at(m_position) >= 'a'
+               && m_buffer.at(m_position) <= 'z')
+        {
+          literal.append(get());
+        }
+        if (literal != "true" && literal != "false" && literal != "null")
+        {
+          fail("invalid literal");
+        }
+        break;
+      }
+      default:
+        static_cast<void>(read_number());
+      }
+    }
+
+#ifdef ANALYZER_X86_KERNELS
+    // Widen the range in minimum and maximum to include a column of scores,
+    // four scores at a time. The columns start on 64-byte boundaries, so
+    // aligned loads are safe.
+    void sse2_column_range(const gsl::span<const score_list::value_type> column,
+                           __m128& minimum,
+                           __m128& maximum) noexcept
+    {
+      static constexpr std::size_t width {4};
+      std::size_t i {0};
+      for (; i + width <= column.size(); i += width)
+      {
+        const auto scores {_mm_load_ps(column.data() + i)};  // NOLINT
+        minimum = _mm_min_ps(minimum, scores);
+        maximum = _mm_max_ps(maximum, scores);
+      }
+      for (; i < column.size(); ++i)
+      {
+        const auto score {_mm_set1_ps(column[i])};
+        minimum = _mm_min_ps(minimum, score);
+        maximum = _mm_max_ps(maximum, score);
+      }
+    }
+
+    [[nodiscard]] auto sse2_score_range(const score_list& scores) noexcept
+    {
+      auto minimum {_mm_set1_ps(scores.x()[0])};
+      auto maximum {minimum};
+      sse2_column_range(scores.x(), minimum, maximum);
+      sse2_column_range(scores.y(), minimum, maximum);
+      // Reduce the four lanes to lane 0.
+      minimum = _mm_min_ps(minimum, _mm_movehl_ps(minimum, minimum));
+      maximum = _mm_max_ps(maximum, _mm_movehl_ps(maximum, maximum));
+      minimum = _mm_min_ss(minimum, _mm_shuffle_ps(minimum, minimum, 1));
+      maximum = _mm_max_ss(maximum, _mm_shuffle_ps(maximum, maximum, 1));
+      return range {_mm_cvtss_f32(minimum), _mm_cvtss_f32(maximum)};
+    }
+#else
+    [[nodiscard]] auto scalar_score_range(const score_list& scores) noexcept
+    {
+      const auto [min_x, max_x] {
+        std::minmax_element(std::begin(scores.x()), std::end(scores.x()))};
+      const auto [min_y, max_y] {
+        std::minmax_element(std::begin(scores.y()), std::end(scores.y()))};
+      return range {std::min(*min_x, *min_y), std::max(*max_x, *max_y)};
+    }
+#endif
+
+    // A score is an array of two numbers. Missing numbers are zero.
+    void read_scores(json_reader& reader, score_list& scores)
+    {
+      read_array(reader, [&reader, &scores](int /*unused*/) {
+        std::array<double, 2> score {0.0, 0.0};
+        read_array(reader, [&reader, &score](const int i) {
+          if (i < 2)
+          {
+            score.at(gsl::narrow_cast<std::size_t>(i)) = reader.read_number();
+          }
+          else
+          {
+            reader.skip_value();
+          }
+        });
+        scores.push_back(gsl::narrow_cast<score_list::value_type>(score[0]),
+                         gsl::narrow_cast<score_list::value_type>(score[1]));
+      });
+    }
+
+    auto read_training_batch(json_reader& reader)
+    {
+      training_batch batch {{}, {}, {}, 0.0f, 0.0f};
+      read_object(reader, [&reader, &batch](const QByteArray& key) {
+        if (key == "background candidates")
+        {
+          read_scores(reader, batch.background_candidates);
+        }
+        else if (key == "background mined")
+        {
+          read_scores(reader, batch.background_mined);
+        }
+        else if (key == "target candidates")
+        {
+          read_scores(reader, batch.target_candidates);
+        }
+        else if (key == "thresholds")
+        {
+          read_array(reader, [&reader, &batch](const int i) {
+            if (i == training_scores::background_scores)
+            {
+              batch.background_threshold
+                = gsl::narrow_cast<float>(reader.read_number());
+            }
+            else if (i == training_scores::target_scores)
+            {
+              batch.target_threshold
+                = gsl::narrow_cast<float>(reader.read_number());
+            }
+            else
+            {
+              reader.skip_value();
+            }
+          });
+        }
+        else
+        {
+          reader.skip_value();
+        }
+      });
+      batch.chart_range = get_chart_range(batch);
       return batch;
     }
 
-    auto parse_training_update(const QJsonArray& json)
+    auto read_training_update(json_reader& reader)
     {
       training_update update;
-      try
+      read_array(reader, [&reader, &update](int /*unused*/) {
+        update.push_back(read_training_batch(reader));
+      });
+      return update;
+    }
+
+    // Record where each batch of an update starts, without parsing it.
+    auto index_training_update(json_reader& reader)
+    {
+      std::vector<qint64> offsets;
+      read_array(reader, [&reader, &offsets](int /*unused*/) {
+        static_cast<void>(reader.peek());
+        offsets.push_back(reader.offset());
+        reader.skip_value();
+      });
+      return offsets;
+    }
+
+    template <typename Update>
+    struct score_file_contents final
+    {
+      QString sequence_name;
+      QString dataset;
+      std::vector<int> update_frames;
+      std::vector<Update> updates;
+    };
+
+    // Read a whole training score file. read_update reads the value of one
+    // member of "data", and returns what to keep for that update.
+    template <typename UpdateReader>
+    auto read_score_file(QFile& file, UpdateReader&& read_update)
+    {
+      using update_type
+        = std::invoke_result_t<UpdateReader, json_reader&>;
+      json_reader reader {file};
+      score_file_contents<update_type> contents;
+      std::vector<std::pair<QString, update_type>> updates;
+      read_object(reader, [&](const QByteArray& key) {
+        if (key == "sequence")
+        {
+          contents.sequence_name = QString::fromUtf8(reader.read_string());
+        }
+        else if (key == "dataset")
+        {
+          contents.dataset = QString::fromUtf8(reader.read_string());
+        }
+        else if (key == "data")
+        {
+          read_object(reader, [&](const QByteArray& frame) {
+            updates.emplace_back(QString::fromUtf8(frame), read_update(reader));
+          });
+        }
+        else
+        {
+          reader.skip_value();
+        }
+      });
+      if (reader.peek() != '\0')
       {
-        update.reserve(gsl::narrow<training_update::size_type>(json.size()));
+        reader.fail("unexpected data after the end of the document");
       }
-      catch (const gsl::narrowing_error&)
+      // Keep the order the updates had when this used QJsonObject, which
+      // sorts its keys as strings.
+      std::stable_sort(
+        std::begin(updates),
+        std::end(updates),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+      contents.update_frames.reserve(updates.size());
+      contents.updates.reserve(updates.size());
+      for (auto& [frame, update] : updates)
       {
-        throw analyzer::parse_error {
-          "Cannot reserve " + std::to_string(json.size())
-          + " training batches in analyzer::parse_training_update()."};
+        contents.update_frames.push_back(frame.toInt());
+        contents.updates.push_back(std::move(update));
       }
-      std::transform(std::begin(json),
-                     std::end(json),
-                     std::back_insert_iterator {update},
-                     [](const QJsonValue& json_value) {
-                       return parse_training_batch(json_value.toObject());
-                     });
-      return update;
+      return contents;
     }
 
-    auto parse_all_training_updates(const QJsonObject& json)
+    auto open_score_file(const QString& path)
     {
-      update_list updates;
-      try
+      if (path.isEmpty())
       {
-        updates.reserve(gsl::narrow<update_list::size_type>(json.size()));
+        throw std::invalid_argument {
+          "The path to the training score data is empty."};
       }
-      catch (const gsl::narrowing_error&)
+      auto file {std::make_unique<QFile>(make_absolute_path(path))};
+      if (!file->open(QIODevice::ReadOnly))
       {
-        throw analyzer::parse_error {
-          "Cannot reserve " + std::to_string(json.size())
-          + " training updates in analyzer::parse_training_updates()."};
+        throw std::runtime_error {"cannot open file"};
       }
-      std::transform(std::begin(json),
-                     std::end(json),
-                     std::back_insert_iterator {updates},
-                     [](const QJsonValue& json_value) {
-                       return parse_training_update(json_value.toArray());
-                     });
-      return updates;
+      return file;
     }
   }  // namespace
 
+  score_list::score_list(const std::initializer_list<QPointF> scores)
+  {
+    reserve(scores.size());
+    for (const auto& score : scores)
+    {
+      push_back(gsl::narrow_cast<value_type>(score.x()),
+                gsl::narrow_cast<value_type>(score.y()));
+    }
+  }
+
+  auto score_list::size() const noexcept -> size_type
+  {
+    return m_x.size();
+  }
+
+  auto score_list::empty() const noexcept -> bool
+  {
+    return m_x.empty();
+  }
+
+  void score_list::reserve(const size_type n)
+  {
+    m_x.reserve(n);
+    m_y.reserve(n);
+  }
+
+  void score_list::push_back(const value_type x, const value_type y)
+  {
+    m_x.push_back(x);
+    m_y.push_back(y);
+  }
+
+  auto score_list::operator[](const size_type i) const -> QPointF
+  {
+    return QPointF {m_x.at(i), m_y.at(i)};
+  }
+
+  auto score_list::x() const noexcept -> gsl::span<const value_type>
+  {
+    return m_x;
+  }
+
+  auto score_list::y() const noexcept -> gsl::span<const value_type>
+  {
+    return m_y;
+  }
+
+  auto score_list::to_points() const -> QVector<QPointF>
+  {
+    QVector<QPointF> points;
+    points.reserve(gsl::narrow<int>(size()));
+    for (size_type i {0}; i < size(); ++i)
+    {
+      points.append(QPointF {m_x[i], m_y[i]});
+    }
+    return points;
+  }
+
+  auto operator==(const score_list& a, const score_list& b) -> bool
+  {
+    const auto ax {a.x()};
+    const auto ay {a.y()};
+    const auto bx {b.x()};
+    const auto by {b.y()};
+    return std::equal(
+             std::begin(ax), std::end(ax), std::begin(bx), std::end(bx))
+           && std::equal(
+             std::begin(ay), std::end(ay), std::begin(by), std::end(by));
+  }
+
+  auto get_chart_range(const score_list& scores) -> range
+  {
+    if (scores.empty())
+    {
+      return range {0.0f, 0.0f};
+    }
+#ifdef ANALYZER_X86_KERNELS
+    return sse2_score_range(scores);
+#else
+    return scalar_score_range(scores);
+#endif
+  }
+
   auto get_chart_range(const training_batch& batch) -> range
   {
-    const auto bg_candidate_range {
-      get_chart_range(batch.background_candidates)};
-    const auto bg_mined_range {get_chart_range(batch.background_mined)};
-    const auto tg_candidate_range {get_chart_range(batch.target_candidates)};
-    return range {std::min(std::min(std::min(std::min(bg_candidate_range.first,
-                                                      bg_mined_range.first),
-                                             tg_candidate_range.first),
-                                    batch.background_threshold),
-                           batch.target_threshold),
-                  std::max(std::max(std::max(std::max(bg_candidate_range.second,
-                                                      bg_mined_range.second),
-                                             tg_candidate_range.second),
-                                    batch.background_threshold),
-                           batch.target_threshold)};
+    if (batch.chart_range)
+    {
+      return *batch.chart_range;
+    }
+    // The thresholds are always charted. An empty list has nothing to chart,
+    // so it mustn't stretch the range to include 0.
+    auto low {std::min(batch.background_threshold, batch.target_threshold)};
+    auto high {std::max(batch.background_threshold, batch.target_threshold)};
+    for (const auto* const scores : {&batch.background_candidates,
+                                     &batch.background_mined,
+                                     &batch.target_candidates})
+    {
+      if (!scores->empty())
+      {
+        const auto scores_range {get_chart_range(*scores)};
+        low = std::min(low, scores_range.first);
+        high = std::max(high, scores_range.second);
+      }
+    }
+    return range {low, high};
   }
 
   auto load_training_scores(const QString& path) -> training_scores
   {
-    if (path.isEmpty())
+    const auto file {open_score_file(path)};
+    auto contents {read_score_file(*file, &read_training_update)};
+    return training_scores {std::move(contents.sequence_name),
+                            std::move(contents.dataset),
+                            std::move(contents.update_frames),
+                            std::move(contents.updates)};
+  }
+
+  training_score_index::training_score_index(
+    const QString& path,
+    const std::size_t cache_capacity):
+    m_file {open_score_file(path)},
+    m_cache_capacity {std::max(cache_capacity, std::size_t {1})}
+  {
+    auto contents {read_score_file(*m_file, &index_training_update)};
+    m_sequence_name = std::move(contents.sequence_name);
+    m_dataset = std::move(contents.dataset);
+    m_update_frames = std::move(contents.update_frames);
+    m_batch_offsets = std::move(contents.updates);
+  }
+
+  // The destructor must be defined where QFile is a complete type.
+  training_score_index::~training_score_index() = default;
+
+  auto training_score_index::sequence_name() const -> const QString&
+  {
+    return m_sequence_name;
+  }
+
+  auto training_score_index::dataset() const -> const QString&
+  {
+    return m_dataset;
+  }
+
+  auto training_score_index::update_frames() const noexcept
+    -> const std::vector<int>&
+  {
+    return m_update_frames;
+  }
+
+  auto training_score_index::update_count() const noexcept
+    -> update_list::size_type
+  {
+    return m_batch_offsets.size();
+  }
+
+  auto training_score_index::batch_count(
+    const update_list::size_type update) const -> training_update::size_type
+  {
+    return m_batch_offsets.at(update).size();
+  }
+
+  auto training_score_index::batch(const training_iterator& position)
+    -> const training_batch&
+  {
+    const auto offset {m_batch_offsets.at(position.current_update)
+                         .at(position.current_batch)};
+    const auto cached {std::find_if(
+      std::begin(m_cache), std::end(m_cache), [&position](const auto& entry) {
+        return entry.first.current_update == position.current_update
+               && entry.first.current_batch == position.current_batch;
+      })};
+    if (cached != std::end(m_cache))
+    {
+      m_cache.splice(std::begin(m_cache), m_cache, cached);
+      return m_cache.front().second;
+    }
+    if (!m_file->seek(offset))
     {
-      throw std::invalid_argument {
-        "The path to the training score data is empty."};
+      throw std::runtime_error {"cannot seek in the training score file"};
     }
-    const auto absolute_path {make_absolute_path(path)};
-    const auto json_data {read_json_data(absolute_path)};
-    const auto score_json {json_data["data"].toObject()};
-    training_scores score_data {json_data["sequence"].toString(),
-                                json_data["dataset"].toString(),
-                                parse_training_score_update_frames(score_json),
-                                parse_all_training_updates(score_json)};
-    return score_data;
+    json_reader reader {*m_file, offset};
+    m_cache.emplace_front(position, read_training_batch(reader));
+    if (m_cache.size() > m_cache_capacity)
+    {
+      m_cache.pop_back();
+    }
+    return m_cache.front().second;
+  }
+
+  auto training_score_index::cached_batch_count() const noexcept
+    -> std::size_t
+  {
+    return m_cache.size();
   }
 }  // namespace analyzer
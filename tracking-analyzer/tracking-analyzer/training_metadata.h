@@ -1,13 +1,97 @@
 #ifndef ANALYZER_TRAINING_METADATA_H
 #define ANALYZER_TRAINING_METADATA_H
 
-#include <QList>
+#include "tracking-analyzer/box_array.h"
 #include <QPointF>
+#include <QString>
+#include <QVector>
+#include <cstddef>
+#include <gsl/span>
+#include <initializer_list>
+#include <list>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
+class QFile;
+
 namespace analyzer
 {
-  using score_list = QList<QPointF>;
+  /**
+   * \brief Store training scores as a structure of float arrays.
+   * \details Each score is a point: its x is the background score, and its y
+   * is the target score. The x values are stored in one contiguous array, and
+   * the y values in another. Each array starts on a 64-byte boundary, like
+   * the columns of a box_array. This takes half the memory of a list of
+   * QPointF, and suits kernels that scan every score, such as
+   * get_chart_range(const score_list&).
+   */
+  class score_list final
+  {
+  public:
+    using value_type = float;
+    using size_type = std::size_t;
+
+    /// The storage for one coordinate of every score.
+    using column = box_array::column;
+
+    /// Construct an empty score list.
+    score_list() = default;
+
+    /**
+     * \brief Construct a score list from points.
+     * \param[in] scores The scores to copy into the list. The coordinates are
+     *    narrowed to float.
+     */
+    score_list(std::initializer_list<QPointF> scores);
+
+    /// Get the number of scores.
+    [[nodiscard]] auto size() const noexcept -> size_type;
+
+    /// Check whether the list has no scores.
+    [[nodiscard]] auto empty() const noexcept -> bool;
+
+    /// Reserve space for \a n scores.
+    void reserve(size_type n);
+
+    /// Append a score to the end of the list.
+    void push_back(value_type x, value_type y);
+
+    /**
+     * \brief Get a copy of one score.
+     * \param[in] i The 0-based index of the score.
+     * \return The score at index \a i.
+     * \throws std::out_of_range If \f$i \ge size()\f$.
+     */
+    [[nodiscard]] auto operator[](size_type i) const -> QPointF;
+
+    /// Get the background scores.
+    [[nodiscard]] auto x() const noexcept -> gsl::span<const value_type>;
+
+    /// Get the target scores.
+    [[nodiscard]] auto y() const noexcept -> gsl::span<const value_type>;
+
+    /// Convert the scores to points, for a chart series.
+    [[nodiscard]] auto to_points() const -> QVector<QPointF>;
+
+  private:
+    column m_x;
+    column m_y;
+  };
+
+  [[nodiscard]] auto operator==(const score_list& a, const score_list& b)
+    -> bool;
+
+  [[nodiscard]] inline auto operator!=(const score_list& a,
+                                       const score_list& b) -> bool
+  {
+    return !(a == b);
+  }
+
+  /// The lowest and highest value on a chart axis.
+  using range = std::pair<float, float>;
 
   struct parse_error: std::runtime_error
   {
@@ -21,6 +105,10 @@ namespace analyzer
     score_list target_candidates;
     float background_threshold;
     float target_threshold;
+
+    /// The range of the scores and thresholds, found when the batch is read
+    /// from a file. If the batch is changed afterwards, reset this.
+    std::optional<range> chart_range {};
   };
 
   using training_update = std::vector<training_batch>;
@@ -42,10 +130,122 @@ namespace analyzer
     training_update::size_type current_batch {0};
   };
 
+  /**
+   * \brief Load training scores from a JSON file.
+   * \param[in] path The path to the JSON file.
+   * \return The scores in the file.
+   * \throws std::invalid_argument If \a path is empty.
+   * \throws std::runtime_error If the file cannot be opened.
+   * \throws analyzer::parse_error If the file isn't valid JSON.
+   * \details The file is read in small chunks, and scores are written
+   * straight into their score lists, so the memory used is the scores
+   * themselves, regardless of the file size. Members the loader doesn't use
+   * are skipped without being stored.
+   *
+   * Duplicate keys aren't an error. If "data" has the same frame more than
+   * once, every one of those updates is kept, in file order; QJsonObject
+   * used to keep only one of them. For other duplicate members, such as
+   * "sequence", the last one wins.
+   */
   [[nodiscard]] auto load_training_scores(const QString& path)
     -> training_scores;
 
-  using range = std::pair<float, float>;
+  /**
+   * \brief Provide access to the batches in a training score file, parsing
+   *    each batch only when it's requested.
+   * \details Opening the file reads through it once, to record where each
+   * batch starts; no scores are stored. Requesting a batch parses just that
+   * batch, and keeps it in a small cache of recently used batches. The memory
+   * used tracks the batches being viewed, not the size of the file.
+   *
+   * The file stays open for the lifetime of the index. If the file changes,
+   * open a new index.
+   */
+  class training_score_index final
+  {
+  public:
+    /// The number of parsed batches to keep, by default.
+    static constexpr std::size_t default_cache_capacity {8};
+
+    /**
+     * \brief Open and index a training score file.
+     * \param[in] path The path to the JSON file.
+     * \param[in] cache_capacity The number of parsed batches to keep. At
+     *    least one batch is always kept.
+     * \throws std::invalid_argument If \a path is empty.
+     * \throws std::runtime_error If the file cannot be opened.
+     * \throws analyzer::parse_error If the file isn't valid JSON.
+     */
+    explicit training_score_index(
+      const QString& path,
+      std::size_t cache_capacity = default_cache_capacity);
+    training_score_index(const training_score_index&) = delete;
+    training_score_index(training_score_index&&) = delete;
+    auto operator=(const training_score_index&)
+      -> training_score_index& = delete;
+    auto operator=(training_score_index&&) -> training_score_index& = delete;
+    ~training_score_index();
+
+    [[nodiscard]] auto sequence_name() const -> const QString&;
+    [[nodiscard]] auto dataset() const -> const QString&;
+    [[nodiscard]] auto update_frames() const noexcept
+      -> const std::vector<int>&;
+
+    /// Get the number of training updates in the file.
+    [[nodiscard]] auto update_count() const noexcept -> update_list::size_type;
+
+    /**
+     * \brief Get the number of batches in one training update.
+     * \throws std::out_of_range If \a update is not a valid update index.
+     */
+    [[nodiscard]] auto batch_count(update_list::size_type update) const
+      -> training_update::size_type;
+
+    /**
+     * \brief Get one batch, parsing it if it isn't cached.
+     * \param[in] position The update and batch to get.
+     * \return The batch. The reference is valid until the next call to
+     *    batch(), which may evict it from the cache.
+     * \throws std::out_of_range If \a position is not a valid batch.
+     * \throws analyzer::parse_error If the batch cannot be parsed, for
+     *    example because the file changed.
+     */
+    [[nodiscard]] auto batch(const training_iterator& position)
+      -> const training_batch&;
+
+    /// Get the number of parsed batches in the cache.
+    [[nodiscard]] auto cached_batch_count() const noexcept -> std::size_t;
+
+  private:
+    std::unique_ptr<QFile> m_file;
+    QString m_sequence_name;
+    QString m_dataset;
+    std::vector<int> m_update_frames;
+
+    // The byte offset of each batch, by update.
+    std::vector<std::vector<qint64>> m_batch_offsets;
+
+    // The front of the list is the most recently used batch.
+    std::size_t m_cache_capacity;
+    std::list<std::pair<training_iterator, training_batch>> m_cache;
+  };
+
+  /**
+   * \brief Find the lowest and highest coordinate in a list of scores.
+   * \param[in] scores The scores to search.
+   * \return The range of the coordinates, or {0, 0} if \a scores is empty.
+   * \details This reads each score once. On x86, it compares four
+   * coordinates at a time.
+   */
+  auto get_chart_range(const score_list& scores) -> range;
+
+  /**
+   * \brief Find the range a chart needs to show a whole training batch.
+   * \param[in] batch The batch to chart.
+   * \return The batch's cached training_batch::chart_range, if it has one.
+   *    Otherwise, the range of the two thresholds and the scores in the three
+   *    lists. Empty lists don't affect the range.
+   */
   auto get_chart_range(const training_batch& batch) -> range;
 }  // namespace analyzer
 
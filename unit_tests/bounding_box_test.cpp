@@ -55,6 +55,16 @@ namespace analyzer_test
       QTest::newRow("floating point boxes")
         << "0.0,0.0,100.3456,73.0540"s
         << analyzer::bounding_box_list {{0.0f, 0.0f, 100.3456f, 73.054f}};
+      QTest::newRow("mixed separators")
+        << "1\t2\t3\t4\n5 6 7 8\n9, 10, 11, 12\n13 ,\t14,15  16"s
+        << analyzer::bounding_box_list {{1.0f, 2.0f, 3.0f, 4.0f},
+                                        {5.0f, 6.0f, 7.0f, 8.0f},
+                                        {9.0f, 10.0f, 11.0f, 12.0f},
+                                        {13.0f, 14.0f, 15.0f, 16.0f}};
+      QTest::newRow("windows line endings and blank lines")
+        << "1,2,3,4\r\n\r\n5,6,7,8\r\n"s
+        << analyzer::bounding_box_list {{1.0f, 2.0f, 3.0f, 4.0f},
+                                        {5.0f, 6.0f, 7.0f, 8.0f}};
     }
 
     void read_valid_bounding_boxes() const
@@ -72,6 +82,13 @@ namespace analyzer_test
       QTest::newRow("three values") << "0,0,0"s;
       QTest::newRow("five values") << "0,0,0,0,0"s;
       QTest::newRow("one invalid row") << "0,0,10,10\n10,11,9,8\n10,11,9"s;
+      QTest::newRow("not a number") << "0,0,ten,10"s;
+      QTest::newRow("trailing text") << "0,0,10,10px"s;
+      QTest::newRow("missing separator") << "0,0,10.5.5,10"s;
+      QTest::newRow("repeated separator") << "1,,2,3,4"s;
+      QTest::newRow("repeated separator with spaces") << "1, ,2,3,4"s;
+      QTest::newRow("leading separator") << ",1,2,3,4"s;
+      QTest::newRow("trailing separator") << "1,2,3,4,"s;
     }
 
     void read_invalid_bounding_boxes() const
@@ -83,6 +100,22 @@ namespace analyzer_test
         analyzer::invalid_data);
     }
 
+    void read_bounding_box_file() const
+    {
+      QCOMPARE(analyzer::read_bounding_box_file(
+                 "test_metadata/tracking_results/MDNet/Basketball.txt"),
+               (analyzer::bounding_box_list {{1.0f, 2.0f, 3.0f, 4.0f},
+                                             {5.0f, 6.0f, 7.0f, 8.0f}}));
+    }
+
+    void read_missing_bounding_box_file() const
+    {
+      QVERIFY_EXCEPTION_THROWN(
+        const auto unused {analyzer::read_bounding_box_file(
+          "test_metadata/no_such_file.txt")},
+        std::runtime_error);
+    }
+
     void calculate_overlaps_data() const { analyzer_test::create_list_data(); }
 
     void calculate_overlaps() const
@@ -0,0 +1,122 @@
+#include "tracking-analyzer/box_array.h"
+#include "test_utilities.h"
+#include <QTest>
+#include <cstdint>
+
+Q_DECLARE_METATYPE(analyzer::bounding_box_list)  // NOLINT
+
+namespace analyzer_test
+{
+  namespace
+  {
+    auto is_aligned(const analyzer::box_array::value_type* const p)
+    {
+      constexpr auto alignment {analyzer::box_array::alignment};
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    }
+
+    // Nine boxes is enough for one pass of the 8-wide kernel, plus a tail.
+    auto make_boxes(const float offset)
+    {
+      analyzer::bounding_box_list boxes;
+      for (int i {0}; i < 9; ++i)
+      {
+        const auto f {static_cast<float>(i)};
+        boxes.push_back({f * 3.0f + offset, f * 2.0f, 10.0f + f, 20.0f - f});
+      }
+      return boxes;
+    }
+  }  // namespace
+
+  class box_array_test final: public QObject
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  private slots:
+    void construct_default_box_array() const
+    {
+      const analyzer::box_array boxes;
+      QVERIFY(boxes.empty());
+      QCOMPARE(boxes.size(), 0ul);
+    }
+
+    void convert_data() const
+    {
+      QTest::addColumn<analyzer::bounding_box_list>("list");
+      QTest::newRow("empty") << analyzer::bounding_box_list {};
+      QTest::newRow("one box")
+        << analyzer::bounding_box_list {{1.0f, 2.0f, 3.0f, 4.0f}};
+      QTest::newRow("many boxes") << make_boxes(0.0f);
+    }
+
+    void convert() const
+    {
+      QFETCH(const analyzer::bounding_box_list, list);
+      const analyzer::box_array boxes {list};
+      QCOMPARE(boxes.size(), list.size());
+      QCOMPARE(boxes.x().size(), list.size());
+      QCOMPARE(boxes.height().size(), list.size());
+      for (std::size_t i {0}; i < list.size(); ++i)
+      {
+        QCOMPARE(boxes[i], list[i]);
+        QCOMPARE(boxes.y()[i], list[i].y);
+        QCOMPARE(boxes.width()[i], list[i].width);
+      }
+      QCOMPARE(analyzer::to_bounding_box_list(boxes), list);
+    }
+
+    void columns_are_aligned() const
+    {
+      const analyzer::box_array boxes {make_boxes(0.0f)};
+      QVERIFY(is_aligned(boxes.x().data()));
+      QVERIFY(is_aligned(boxes.y().data()));
+      QVERIFY(is_aligned(boxes.width().data()));
+      QVERIFY(is_aligned(boxes.height().data()));
+    }
+
+    void index_throws() const
+    {
+      const analyzer::box_array boxes {make_boxes(0.0f)};
+      QVERIFY_EXCEPTION_THROWN([[maybe_unused]] const auto b {boxes[9]},
+                               std::out_of_range);
+    }
+
+    void push_back() const
+    {
+      analyzer::box_array boxes;
+      boxes.push_back({1.0f, 2.0f, 3.0f, 4.0f});
+      QCOMPARE(boxes.size(), 1ul);
+      QCOMPARE(boxes[0], (analyzer::bounding_box {1.0f, 2.0f, 3.0f, 4.0f}));
+    }
+
+    void metrics_match_bounding_box_list() const
+    {
+      const auto a {make_boxes(0.0f)};
+      const auto b {make_boxes(4.0f)};
+      const analyzer::box_array soa_a {a};
+      const analyzer::box_array soa_b {b};
+      QCOMPARE(analyzer::calculate_overlaps(soa_a, soa_b),
+               analyzer::calculate_overlaps(a, b));
+      QCOMPARE(analyzer::calculate_offsets(soa_a, soa_b),
+               analyzer::calculate_offsets(a, b));
+    }
+
+    void metrics_throw_for_different_sizes() const
+    {
+      const analyzer::box_array a {make_boxes(0.0f)};
+      const analyzer::box_array b;
+      QVERIFY_EXCEPTION_THROWN(
+        [[maybe_unused]] const auto o {analyzer::calculate_overlaps(a, b)},
+        std::invalid_argument);
+      QVERIFY_EXCEPTION_THROWN(
+        [[maybe_unused]] const auto o {analyzer::calculate_offsets(a, b)},
+        std::invalid_argument);
+    }
+  };
+}  // namespace analyzer_test
+
+// NOLINTNEXTLINE(modernize-use-trailing-return-type)
+QTEST_APPLESS_MAIN(analyzer_test::box_array_test)
+#include "box_array_test.moc"
@@ -0,0 +1,183 @@
+#include "test_utilities.h"
+#include "tracking-analyzer/dataset_index.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+namespace analyzer_test
+{
+  namespace
+  {
+    void write_file(const QString& path, const QByteArray& contents)
+    {
+      QFile file {path};
+      QVERIFY(file.open(QIODevice::WriteOnly));
+      QCOMPARE(file.write(contents), qint64 {contents.size()});
+    }
+
+    // Make a dataset with one valid sequence, Deer, and one sequence without
+    // frames, Empty.
+    void make_dataset(const QString& root)
+    {
+      QVERIFY(QDir {}.mkpath(root + "/Deer/img"));
+      QVERIFY(QDir {}.mkpath(root + "/Empty"));
+      write_file(root + "/Deer/img/0001.jpg", {});
+      write_file(root + "/Deer/img/0002.jpg", {});
+      write_file(root + "/Deer/groundtruth_rect.txt", "1,2,3,4\n5,6,7,8\n");
+      write_file(root + "/Deer/attrs.txt", "IV, OCC");
+    }
+  }  // namespace
+
+  class dataset_index_test final: public QObject
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  private slots:
+    void round_trip() const
+    {
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto root {directory.filePath("dataset")};
+      make_dataset(root);
+      analyzer::dataset_load_options options;
+      options.index_path = directory.filePath("nested/dataset.index");
+      analyzer::load_error_list skipped;
+      const auto loaded {analyzer::load_dataset(root, options, skipped)};
+      QCOMPARE(skipped.size(), std::size_t {1});
+      QVERIFY(QFile::exists(options.index_path));
+
+      analyzer::load_error_list index_skipped;
+      const auto indexed {
+        analyzer::read_dataset_index(options.index_path, root, index_skipped)};
+      QVERIFY(indexed);
+      QCOMPARE(indexed->sequences().size(), 1);
+      const auto& deer {indexed->sequences().front()};
+      QVERIFY(deer.is_loaded());
+      QCOMPARE(deer.name(), QString {"Deer"});
+      QCOMPARE(deer.frame_paths(), loaded.sequences().front().frame_paths());
+      QVERIFY(deer.frames().is_numbered());
+      QCOMPARE(deer.target_boxes(),
+               (analyzer::bounding_box_list {{1.0f, 2.0f, 3.0f, 4.0f},
+                                             {5.0f, 6.0f, 7.0f, 8.0f}}));
+      QCOMPARE(deer.tags(),
+               (QStringList {"illumination variation", "occlusion"}));
+      QCOMPARE(index_skipped.size(), std::size_t {1});
+      QCOMPARE(index_skipped.front().path, skipped.front().path);
+    }
+
+    void unwritable_index_is_reported_separately() const
+    {
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto root {directory.filePath("dataset")};
+      make_dataset(root);
+      analyzer::dataset_load_options options;
+      // The index directory would have to be a regular file.
+      options.index_path = root + "/Deer/attrs.txt/dataset.index";
+      analyzer::load_error_list skipped;
+      std::optional<analyzer::load_error> index_error;
+      const auto loaded {
+        analyzer::load_dataset(root, options, skipped, index_error)};
+      QCOMPARE(loaded.sequences().size(), 1);
+      QCOMPARE(skipped.size(), std::size_t {1});
+      QCOMPARE(QFileInfo {QString::fromStdString(skipped.front().path)}
+                 .fileName(),
+               QString {"Empty"});
+      QVERIFY(index_error);
+      QCOMPARE(index_error->path, options.index_path.toStdString());
+
+      skipped.clear();
+      static_cast<void>(analyzer::load_dataset(root, options, skipped));
+      QCOMPARE(skipped.size(), std::size_t {1});
+    }
+
+    void changed_sequence_invalidates_index() const
+    {
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto root {directory.filePath("dataset")};
+      make_dataset(root);
+      const auto index_path {directory.filePath("dataset.index")};
+      analyzer::write_dataset_index(
+        index_path, analyzer::load_dataset(root), {});
+      analyzer::load_error_list skipped;
+      QVERIFY(analyzer::read_dataset_index(index_path, root, skipped));
+      // Changing the size of the file changes its stamp, even if the
+      // modification time has too coarse a resolution to change.
+      write_file(root + "/Deer/groundtruth_rect.txt", "1,2,3,4\n");
+      QVERIFY(!analyzer::read_dataset_index(index_path, root, skipped));
+    }
+
+    void stamps_match_the_loaded_data() const
+    {
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto root {directory.filePath("dataset")};
+      make_dataset(root);
+      const auto index_path {directory.filePath("dataset.index")};
+      const auto data {analyzer::load_dataset(root)};
+      // The index must not pair the old boxes with the new file's stamp.
+      write_file(root + "/Deer/groundtruth_rect.txt", "1,2,3,4\n");
+      analyzer::write_dataset_index(index_path, data, {});
+      analyzer::load_error_list skipped;
+      QVERIFY(!analyzer::read_dataset_index(index_path, root, skipped));
+    }
+
+    void index_is_for_one_dataset() const
+    {
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto root {directory.filePath("dataset")};
+      make_dataset(root);
+      const auto index_path {directory.filePath("dataset.index")};
+      analyzer::write_dataset_index(
+        index_path, analyzer::load_dataset(root), {});
+      analyzer::load_error_list skipped;
+      QVERIFY(!analyzer::read_dataset_index(
+        index_path, directory.filePath("other"), skipped));
+    }
+
+    void invalid_files_are_ignored_data() const
+    {
+      QTest::addColumn<QByteArray>("contents");
+      QTest::newRow("empty file") << QByteArray {};
+      QTest::newRow("garbage") << QByteArray {"not an index at all"};
+    }
+
+    void invalid_files_are_ignored() const
+    {
+      QFETCH(const QByteArray, contents);
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto index_path {directory.filePath("dataset.index")};
+      write_file(index_path, contents);
+      analyzer::load_error_list skipped;
+      QVERIFY(!analyzer::read_dataset_index(
+        index_path, directory.filePath("dataset"), skipped));
+      QVERIFY(skipped.empty());
+    }
+
+    void rebuild_ignores_index() const
+    {
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto root {directory.filePath("dataset")};
+      make_dataset(root);
+      analyzer::dataset_load_options options;
+      options.index_path = directory.filePath("dataset.index");
+      write_file(options.index_path, "not an index at all");
+      options.rebuild_index = true;
+      analyzer::load_error_list skipped;
+      const auto loaded {analyzer::load_dataset(root, options, skipped)};
+      QCOMPARE(loaded.sequences().size(), 1);
+      QVERIFY(analyzer::read_dataset_index(options.index_path, root, skipped));
+    }
+  };
+}  // namespace analyzer_test
+
+// NOLINTNEXTLINE(modernize-use-trailing-return-type)
+QTEST_APPLESS_MAIN(analyzer_test::dataset_index_test)
+#include "dataset_index_test.moc"
@@ -72,6 +72,19 @@ namespace analyzer_test
       QTEST(analyzer::load_dataset(path), "dataset");
     }
 
+    void report_skipped_sequences() const
+    {
+      analyzer::load_error_list skipped;
+      const auto d {analyzer::load_dataset(
+        "test_dataset", analyzer::dataset_load_options {}, skipped)};
+      QCOMPARE(analyzer::sequence_names(d.sequences()),
+               QStringList {"Biker"});
+      QCOMPARE(skipped.size(), std::size_t {3});
+      QCOMPARE(skipped[0].path, "test_dataset/Basketball"s);
+      QCOMPARE(skipped[1].path, "test_dataset/Bird1"s);
+      QCOMPARE(skipped[2].path, "test_dataset/Bird2"s);
+    }
+
     void construct_invalid_sequence_data() const
     {
       QTest::addColumn<QString>("path");
@@ -108,6 +121,47 @@ namespace analyzer_test
       QCOMPARE(biker.frame_paths(), expected_paths);
     }
 
+    void construct_lazy_sequence() const
+    {
+      const analyzer::sequence biker {
+        "Biker", "test_dataset/Biker", analyzer::load_mode::lazy};
+      QVERIFY(!biker.is_loaded());
+      QCOMPARE(biker.name(), QString {"Biker"});
+      QVERIFY(!biker.is_loaded());
+      QCOMPARE(biker.frame_paths().size(), 3);
+      QVERIFY(biker.is_loaded());
+    }
+
+    void copies_of_lazy_sequence_share_data() const
+    {
+      const analyzer::sequence biker {
+        "Biker", "test_dataset/Biker", analyzer::load_mode::lazy};
+      const auto copy {biker};
+      biker.load();
+      QVERIFY(copy.is_loaded());
+    }
+
+    void load_invalid_lazy_sequence() const
+    {
+      const analyzer::sequence basketball {
+        "Basketball", "test_dataset/Basketball", analyzer::load_mode::lazy};
+      QVERIFY_EXCEPTION_THROWN(basketball.load(), analyzer::invalid_sequence);
+      QVERIFY(!basketball.is_loaded());
+    }
+
+    void load_lazy_dataset() const
+    {
+      const auto d {analyzer::load_dataset(
+        "test_dataset",
+        analyzer::dataset_load_options {analyzer::load_mode::lazy})};
+      QCOMPARE(analyzer::sequence_names(d.sequences()),
+               (QStringList {"Basketball", "Biker", "Bird1", "Bird2"}));
+      for (const auto& s : d.sequences())
+      {
+        QVERIFY(!s.is_loaded());
+      }
+    }
+
     void sequence_names_data() const
     {
       using sequence_list = QVector<analyzer::sequence>;
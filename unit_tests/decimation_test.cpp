@@ -0,0 +1,147 @@
+#include "tracking-analyzer/decimation.h"
+#include <QTest>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+Q_DECLARE_METATYPE(analyzer::score_list)  // NOLINT
+
+namespace analyzer_test
+{
+  class decimation_test final: public QObject
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  private slots:
+    void decimate_to_grid_throws_data() const
+    {
+      QTest::addColumn<int>("columns");
+      QTest::addColumn<int>("rows");
+      QTest::newRow("no columns") << 0 << 2;
+      QTest::newRow("no rows") << 2 << 0;
+      QTest::newRow("negative") << -1 << -1;
+    }
+
+    void decimate_to_grid_throws() const
+    {
+      QFETCH(const int, columns);
+      QFETCH(const int, rows);
+      QVERIFY_EXCEPTION_THROWN(
+        const auto points {analyzer::decimate_to_grid(
+          {}, {0.0f, 1.0f}, {0.0f, 1.0f}, columns, rows)},
+        std::invalid_argument);
+    }
+
+    void decimate_to_grid_data() const
+    {
+      QTest::addColumn<analyzer::score_list>("scores");
+      QTest::addColumn<analyzer::range>("x_range");
+      QTest::addColumn<analyzer::range>("y_range");
+      QTest::addColumn<QVector<QPointF>>("expected_points");
+      QTest::newRow("empty") << analyzer::score_list {}
+                             << analyzer::range {0.0f, 1.0f}
+                             << analyzer::range {0.0f, 1.0f}
+                             << QVector<QPointF> {};
+      QTest::newRow("first score per cell")
+        << analyzer::score_list {{0.25, 0.25},
+                                 {0.75, 0.25},
+                                 {0.375, 0.125},
+                                 {0.875, 0.875},
+                                 {0.75, 0.5}}
+        << analyzer::range {0.0f, 1.0f} << analyzer::range {0.0f, 1.0f}
+        << QVector<QPointF> {{0.25, 0.25}, {0.75, 0.25}, {0.875, 0.875}};
+      QTest::newRow("end of range is in the last cell")
+        << analyzer::score_list {{1.0, 1.0}, {0.75, 0.75}}
+        << analyzer::range {0.0f, 1.0f} << analyzer::range {0.0f, 1.0f}
+        << QVector<QPointF> {{1.0, 1.0}};
+      QTest::newRow("outside the grid")
+        << analyzer::score_list {{-1.0, 0.5},
+                                 {0.5, 2.0},
+                                 {std::numeric_limits<double>::quiet_NaN(),
+                                  0.5},
+                                 {0.25, 0.75}}
+        << analyzer::range {0.0f, 1.0f} << analyzer::range {0.0f, 1.0f}
+        << QVector<QPointF> {{0.25, 0.75}};
+      QTest::newRow("empty range")
+        << analyzer::score_list {{5.0, 0.25}, {5.0, 0.375}, {5.0, 0.75}}
+        << analyzer::range {5.0f, 5.0f} << analyzer::range {0.0f, 1.0f}
+        << QVector<QPointF> {{5.0, 0.25}, {5.0, 0.75}};
+    }
+
+    void decimate_to_grid() const
+    {
+      QFETCH(const analyzer::score_list, scores);
+      QFETCH(const analyzer::range, x_range);
+      QFETCH(const analyzer::range, y_range);
+      QTEST(analyzer::decimate_to_grid(scores, x_range, y_range, 2, 2),
+            "expected_points");
+    }
+
+    void decimate_to_grid_bounds_point_count() const
+    {
+      analyzer::score_list scores;
+      for (int i {0}; i < 10000; ++i)
+      {
+        scores.push_back(static_cast<float>(i % 101),
+                         static_cast<float>(i % 97));
+      }
+      const auto points {analyzer::decimate_to_grid(
+        scores, {0.0f, 100.0f}, {0.0f, 96.0f}, 8, 4)};
+      QCOMPARE(points.size(), 32);
+    }
+
+    void downsample_lttb_throws() const
+    {
+      const std::vector<float> values {0.0f, 1.0f, 2.0f, 3.0f};
+      QVERIFY_EXCEPTION_THROWN(
+        const auto points {analyzer::downsample_lttb(values, 2)},
+        std::invalid_argument);
+    }
+
+    void downsample_lttb_data() const
+    {
+      QTest::addColumn<std::vector<float>>("values");
+      QTest::addColumn<int>("threshold");
+      QTest::addColumn<QVector<QPointF>>("expected_points");
+      QTest::newRow("empty") << std::vector<float> {} << 3
+                             << QVector<QPointF> {};
+      QTest::newRow("fewer values than the threshold")
+        << std::vector<float> {0.5f, 0.25f} << 3
+        << QVector<QPointF> {{0.0, 0.5}, {1.0, 0.25}};
+      QTest::newRow("one bucket keeps the peak")
+        << std::vector<float> {0.0f, 1.0f, 0.0f, 5.0f, 0.0f, 1.0f, 0.0f} << 3
+        << QVector<QPointF> {{0.0, 0.0}, {3.0, 5.0}, {6.0, 0.0}};
+      QTest::newRow("two buckets keep the dips")
+        << std::vector<float> {1.0f, 0.0f, 1.0f, 1.0f, 1.0f, -2.0f, 1.0f, 1.0f}
+        << 4
+        << QVector<QPointF> {{0.0, 1.0}, {1.0, 0.0}, {5.0, -2.0}, {7.0, 1.0}};
+    }
+
+    void downsample_lttb() const
+    {
+      QFETCH(const std::vector<float>, values);
+      QFETCH(const int, threshold);
+      QTEST(analyzer::downsample_lttb(values, threshold), "expected_points");
+    }
+
+    void downsample_lttb_keeps_threshold_points() const
+    {
+      std::vector<float> values(10000);
+      for (std::vector<float>::size_type i {0}; i < values.size(); ++i)
+      {
+        values[i] = std::sin(static_cast<float>(i) / 100.0f);
+      }
+      values[5000] = 10.0f;
+      const auto points {analyzer::downsample_lttb(values, 100)};
+      QCOMPARE(points.size(), 100);
+      QCOMPARE(points.front(), (QPointF {0.0, 0.0}));
+      QCOMPARE(points.back().x(), 9999.0);
+      QVERIFY(points.contains(QPointF {5000.0, 10.0}));
+    }
+  };
+}  // namespace analyzer_test
+
+// NOLINTNEXTLINE(modernize-use-trailing-return-type)
+QTEST_APPLESS_MAIN(analyzer_test::decimation_test)
+#include "decimation_test.moc"
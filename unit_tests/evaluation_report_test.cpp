@@ -0,0 +1,91 @@
+#include "tracking-analyzer/evaluation_report.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+
+namespace analyzer_test
+{
+  namespace
+  {
+    auto make_curves(const double success, const double precision)
+    {
+      analyzer::performance_curves curves;
+      curves.success.fill(success);
+      curves.precision.fill(precision);
+      return curves;
+    }
+
+    // An invalid report parses to an empty object, which fails the checks.
+    auto parse(const QByteArray& report)
+    {
+      return QJsonDocument::fromJson(report).object();
+    }
+  }  // namespace
+
+  class evaluation_report_test final: public QObject
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  private slots:
+    void empty_report() const
+    {
+      const auto report {parse(analyzer::make_evaluation_report({}, {}))};
+      QCOMPARE(report["trackers"].toArray(), QJsonArray {});
+      QCOMPARE(report["skipped"].toArray(), QJsonArray {});
+    }
+
+    void tracker_report() const
+    {
+      analyzer::tracker_evaluation evaluation;
+      evaluation.name = "MDNet";
+      evaluation.sequences = {{"Basketball", make_curves(1.0, 0.5)},
+                              {"Biker", make_curves(0.5, 0.25)}};
+      evaluation.overall = make_curves(0.75, 0.375);
+      evaluation.tags = {{"occlusion", make_curves(0.5, 0.25)}};
+      const auto report {
+        parse(analyzer::make_evaluation_report({evaluation}, {}))};
+      const auto trackers {report["trackers"].toArray()};
+      QCOMPARE(trackers.size(), 1);
+      const auto tracker {trackers[0].toObject()};
+      QCOMPARE(tracker["name"].toString(), QString {"MDNet"});
+      QCOMPARE(tracker["success"].toDouble(),
+               analyzer::area_under_curve(evaluation.overall.success));
+      QCOMPARE(tracker["precision"].toDouble(), 0.375);
+      QCOMPARE(tracker["success curve"].toArray().size(),
+               static_cast<int>(analyzer::success_threshold_count));
+      QCOMPARE(tracker["precision curve"].toArray().size(),
+               static_cast<int>(analyzer::precision_threshold_count));
+      QCOMPARE(tracker["precision curve"].toArray()[0].toDouble(), 0.375);
+
+      const auto sequences {tracker["sequences"].toArray()};
+      QCOMPARE(sequences.size(), 2);
+      QCOMPARE(sequences[0].toObject()["name"].toString(),
+               QString {"Basketball"});
+      QCOMPARE(sequences[0].toObject()["precision"].toDouble(), 0.5);
+      QCOMPARE(sequences[1].toObject()["name"].toString(), QString {"Biker"});
+      QCOMPARE(sequences[1].toObject()["precision"].toDouble(), 0.25);
+
+      const auto tags {tracker["tags"].toObject()};
+      QCOMPARE(tags.keys(), QStringList {"occlusion"});
+      QCOMPARE(tags["occlusion"].toObject()["precision"].toDouble(), 0.25);
+    }
+
+    void skipped_report() const
+    {
+      const auto report {parse(analyzer::make_evaluation_report(
+        {}, {{"/data/Biker/groundtruth_rect.txt", "bad box"}}))};
+      const auto skipped {report["skipped"].toArray()};
+      QCOMPARE(skipped.size(), 1);
+      QCOMPARE(skipped[0].toObject()["path"].toString(),
+               QString {"/data/Biker/groundtruth_rect.txt"});
+      QCOMPARE(skipped[0].toObject()["message"].toString(),
+               QString {"bad box"});
+    }
+  };
+}  // namespace analyzer_test
+
+// NOLINTNEXTLINE(modernize-use-trailing-return-type)
+QTEST_APPLESS_MAIN(analyzer_test::evaluation_report_test)
+#include "evaluation_report_test.moc"
@@ -0,0 +1,182 @@
+#include "tracking-analyzer/evaluation.h"
+#include <QTest>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std::literals::string_literals;
+
+namespace analyzer_test
+{
+  namespace
+  {
+    // Calculate the curves the slow way, by comparing every frame to every
+    // threshold.
+    auto brute_force_curves(const analyzer::frame_metrics& metrics)
+    {
+      analyzer::performance_curves curves;
+      for (std::size_t i {0}; i < analyzer::success_threshold_count; ++i)
+      {
+        const auto count {std::count_if(
+          std::begin(metrics.overlaps),
+          std::end(metrics.overlaps),
+          [i](const analyzer::overlap o) {
+            return static_cast<double>(o) > analyzer::success_threshold(i);
+          })};
+        curves.success.at(i) = static_cast<double>(count)
+                               / static_cast<double>(metrics.overlaps.size());
+      }
+      for (std::size_t i {0}; i < analyzer::precision_threshold_count; ++i)
+      {
+        const auto count {std::count_if(
+          std::begin(metrics.offsets),
+          std::end(metrics.offsets),
+          [i](const analyzer::offset e) {
+            return static_cast<double>(e) <= analyzer::precision_threshold(i);
+          })};
+        curves.precision.at(i) = static_cast<double>(count)
+                                 / static_cast<double>(metrics.offsets.size());
+      }
+      return curves;
+    }
+  }  // namespace
+
+  class evaluation_test final: public QObject
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  private slots:
+    void thresholds_test() const
+    {
+      QCOMPARE(analyzer::success_threshold(0), 0.0);
+      QCOMPARE(analyzer::success_threshold(20), 1.0);
+      QCOMPARE(analyzer::precision_threshold(50), 50.0);
+    }
+
+    void empty_curves_test() const
+    {
+      const auto curves {analyzer::calculate_curves({})};
+      QCOMPARE(analyzer::area_under_curve(curves.success), 0.0);
+      QCOMPARE(analyzer::precision_score(curves.precision), 0.0);
+    }
+
+    void curves_test() const
+    {
+      // Include overlaps exactly on the thresholds, and offsets exactly on
+      // whole pixels, because those are where the histogram bins can be off
+      // by one.
+      const auto nan {std::numeric_limits<float>::quiet_NaN()};
+      analyzer::frame_metrics metrics;
+      for (int i {0}; i < 200; ++i)
+      {
+        const auto f {static_cast<float>(i)};
+        metrics.overlaps.push_back(
+          i % 3 == 0 ? static_cast<float>(analyzer::success_threshold(
+            static_cast<std::size_t>(i % 21)))
+                     : std::fmod(f * 0.0137f, 1.0f));
+        metrics.offsets.push_back(i % 4 == 0 ? std::floor(f * 0.3f)
+                                             : f * 0.337f);
+      }
+      metrics.overlaps.at(7) = nan;
+      metrics.offsets.at(7) = nan;
+      const auto curves {analyzer::calculate_curves(metrics)};
+      const auto expected {brute_force_curves(metrics)};
+      QCOMPARE(curves.success, expected.success);
+      QCOMPARE(curves.precision, expected.precision);
+    }
+
+    void scores_test() const
+    {
+      const analyzer::frame_metrics metrics {{0.0f, 0.5f, 1.0f, 1.0f},
+                                             {0.0f, 20.0f, 20.5f, 60.0f}};
+      const auto curves {analyzer::calculate_curves(metrics)};
+      QCOMPARE(curves.success.at(0), 0.75);
+      QCOMPARE(curves.success.at(10), 0.5);
+      QCOMPARE(curves.success.at(20), 0.0);
+      QCOMPARE(analyzer::precision_score(curves.precision), 0.5);
+      QCOMPARE(curves.precision.at(21), 0.75);
+      QCOMPARE(curves.precision.at(50), 0.75);
+      QCOMPARE(analyzer::area_under_curve(curves.success), 12.5 / 21.0);
+    }
+
+    void evaluate_test() const
+    {
+      analyzer::results_database db;
+      db.trackers().emplace_back(
+        "MDNet",
+        analyzer::tracker_results::sequence_list {
+          {"Deer", {{0.0f, 0.0f, 2.0f, 2.0f}, {0.0f, 0.0f, 2.0f, 2.0f}}},
+          {"Bolt", {{0.0f, 0.0f, 2.0f, 2.0f}}}});
+      db.trackers().emplace_back(
+        "VITAL",
+        analyzer::tracker_results::sequence_list {
+          {"Bolt", {{10.0f, 10.0f, 2.0f, 2.0f}}}});
+      const analyzer::box_array deer {
+        {{0.0f, 0.0f, 2.0f, 2.0f}, {1.0f, 0.0f, 2.0f, 2.0f}}};
+      const analyzer::box_array bolt {{{0.0f, 0.0f, 2.0f, 2.0f}}};
+      const std::vector<analyzer::evaluation_sequence> sequences {
+        {"Deer", &deer, {"occlusion"}},
+        {"Bolt", &bolt, {"motion blur", "occlusion"}}};
+
+      const auto evaluations {analyzer::evaluate(db, sequences, 2)};
+      QCOMPARE(evaluations.size(), 2ul);
+      const auto& mdnet {evaluations.at(0)};
+      QCOMPARE(mdnet.name, "MDNet"s);
+      QCOMPARE(mdnet.sequences.size(), 2ul);
+      QCOMPARE(mdnet.sequences.at(0).name, "Deer"s);
+      QCOMPARE(mdnet.sequences.at(0).curves.success.at(10), 0.5);
+      QCOMPARE(mdnet.sequences.at(1).curves.success.at(10), 1.0);
+      QCOMPARE(mdnet.overall.success.at(10), 0.75);
+      QCOMPARE(mdnet.tags.size(), 2ul);
+      QCOMPARE(mdnet.tags.at("occlusion").success.at(10), 0.75);
+      QCOMPARE(mdnet.tags.at("motion blur").success.at(10), 1.0);
+
+      // VITAL has no results for Deer, so only Bolt counts.
+      const auto& vital {evaluations.at(1)};
+      QCOMPARE(vital.sequences.size(), 1ul);
+      QCOMPARE(vital.overall.success.at(0), 0.0);
+      QCOMPARE(analyzer::precision_score(vital.overall.precision), 1.0);
+    }
+
+    void evaluate_mismatched_sizes_test() const
+    {
+      analyzer::results_database db;
+      db.trackers().emplace_back(
+        "MDNet",
+        analyzer::tracker_results::sequence_list {
+          {"Deer", {{0.0f, 0.0f, 2.0f, 2.0f}}}});
+      const analyzer::box_array deer {
+        {{0.0f, 0.0f, 2.0f, 2.0f}, {1.0f, 0.0f, 2.0f, 2.0f}}};
+      const auto evaluations {analyzer::evaluate(db, {{"Deer", &deer, {}}})};
+      QCOMPARE(evaluations.size(), 1ul);
+      QVERIFY(evaluations.front().sequences.empty());
+    }
+
+    void evaluate_skips_mismatched_sizes_test() const
+    {
+      analyzer::results_database db;
+      db.trackers().emplace_back(
+        "MDNet",
+        analyzer::tracker_results::sequence_list {
+          {"Deer", {{0.0f, 0.0f, 2.0f, 2.0f}}},
+          {"Bolt", {{0.0f, 0.0f, 2.0f, 2.0f}}}});
+      const analyzer::box_array deer {
+        {{0.0f, 0.0f, 2.0f, 2.0f}, {1.0f, 0.0f, 2.0f, 2.0f}}};
+      const analyzer::box_array bolt {{{0.0f, 0.0f, 2.0f, 2.0f}}};
+      analyzer::load_error_list skipped;
+      const auto evaluations {analyzer::evaluate(
+        db, {{"Deer", &deer, {}}, {"Bolt", &bolt, {}}}, 2, skipped)};
+      QCOMPARE(skipped.size(), 1ul);
+      QCOMPARE(skipped.front().path, "MDNet/Deer"s);
+      QCOMPARE(evaluations.size(), 1ul);
+      QCOMPARE(evaluations.front().sequences.size(), 1ul);
+      QCOMPARE(evaluations.front().sequences.front().name, "Bolt"s);
+      QCOMPARE(evaluations.front().overall.success.at(10), 1.0);
+    }
+  };
+}  // namespace analyzer_test
+
+// NOLINTNEXTLINE(modernize-use-trailing-return-type)
+QTEST_APPLESS_MAIN(analyzer_test::evaluation_test)
+#include "evaluation_test.moc"
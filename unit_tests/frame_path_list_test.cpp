@@ -0,0 +1,73 @@
+#include "tracking-analyzer/frame_path_list.h"
+#include <QTest>
+
+namespace analyzer_test
+{
+  class frame_path_list_test final: public QObject
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  private slots:
+    void construct_default_list() const
+    {
+      const analyzer::frame_path_list paths;
+      QVERIFY(paths.empty());
+      QCOMPARE(paths.size(), 0);
+      QVERIFY(paths.to_string_list().isEmpty());
+    }
+
+    void construct_list_data() const
+    {
+      QTest::addColumn<QStringList>("file_names");
+      QTest::addColumn<bool>("numbered");
+      QTest::newRow("OTB numbering")
+        << QStringList {"0001.jpg", "0002.jpg", "0003.jpg"} << true;
+      QTest::newRow("prefix and suffix")
+        << QStringList {"frame_0098.jpg", "frame_0099.jpg", "frame_0100.jpg"}
+        << true;
+      QTest::newRow("one frame") << QStringList {"00000001.jpg"} << true;
+      QTest::newRow("gap in numbers")
+        << QStringList {"0001.jpg", "0003.jpg", "0004.jpg"} << false;
+      QTest::newRow("different widths")
+        << QStringList {"1.jpg", "10.jpg", "2.jpg"} << false;
+      QTest::newRow("no numbers")
+        << QStringList {"first.jpg", "second.jpg"} << false;
+      QTest::newRow("non-ASCII names")
+        << QStringList {QString::fromUtf8("b\xc3\xa4r.jpg"), "f\xc3\xbc.jpg"}
+        << false;
+    }
+
+    void construct_list() const
+    {
+      QFETCH(const QStringList, file_names);
+      const analyzer::frame_path_list paths {"/data/img", file_names};
+      QTEST(paths.is_numbered(), "numbered");
+      QCOMPARE(paths.size(), file_names.size());
+      QCOMPARE(paths.directory(), QString {"/data/img"});
+      QStringList expected_paths;
+      for (int i {0}; i < file_names.size(); ++i)
+      {
+        QCOMPARE(paths.file_name(i), file_names[i]);
+        expected_paths.push_back("/data/img/" + file_names[i]);
+      }
+      QCOMPARE(paths[0], expected_paths[0]);
+      QCOMPARE(paths.to_string_list(), expected_paths);
+    }
+
+    void construct_list_from_pattern() const
+    {
+      const analyzer::frame_path_list original {
+        "/data/img", {"frame_0098.jpg", "frame_0099.jpg", "frame_0100.jpg"}};
+      const auto pattern {original.pattern()};
+      QVERIFY(pattern);
+      const analyzer::frame_path_list copy {"/data/img", *pattern, 3};
+      QCOMPARE(copy.to_string_list(), original.to_string_list());
+      QCOMPARE(copy.file_names(), original.file_names());
+    }
+  };
+}  // namespace analyzer_test
+
+// NOLINTNEXTLINE(modernize-use-trailing-return-type)
+QTEST_APPLESS_MAIN(analyzer_test::frame_path_list_test)
+#include "frame_path_list_test.moc"
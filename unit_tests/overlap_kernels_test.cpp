@@ -0,0 +1,113 @@
+#include "tracking-analyzer/box_array.h"
+#include "tracking-analyzer/overlap_kernels.h"
+#include <QTest>
+#include <cstring>
+#include <random>
+
+Q_DECLARE_METATYPE(analyzer::instruction_set)  // NOLINT
+
+namespace analyzer_test
+{
+  namespace
+  {
+    // Make pairs of boxes that cover the interesting cases: random overlaps,
+    // disjoint boxes, coincident boxes, boxes that only touch, and empty boxes.
+    auto make_box_pairs(const std::size_t count)
+    {
+      std::mt19937 generator {7};
+      std::uniform_real_distribution<float> position {-50.0f, 150.0f};
+      std::uniform_real_distribution<float> size {0.0f, 100.0f};
+      std::uniform_int_distribution<int> special_case {0, 9};
+      analyzer::bounding_box_list a;
+      analyzer::bounding_box_list b;
+      for (std::size_t i {0}; i < count; ++i)
+      {
+        a.push_back({position(generator),
+                     position(generator),
+                     size(generator),
+                     size(generator)});
+        b.push_back({position(generator),
+                     position(generator),
+                     size(generator),
+                     size(generator)});
+        switch (special_case(generator))
+        {
+          case 0:
+            b.back() = a.back();
+            break;
+          case 1:
+            b.back() = a.back();
+            b.back().x = a.back().x + a.back().width;
+            break;
+          case 2:
+            a.back().width = 0.0f;
+            break;
+          default:
+            break;
+        }
+      }
+      return std::make_pair(a, b);
+    }
+  }  // namespace
+
+  class overlap_kernels_test final: public QObject
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  private slots:
+    void scalar_is_always_supported() const
+    {
+      QVERIFY(analyzer::is_supported(analyzer::instruction_set::scalar));
+      QVERIFY(analyzer::is_supported(analyzer::best_instruction_set()));
+    }
+
+    void calculate_overlaps_data() const
+    {
+      QTest::addColumn<analyzer::instruction_set>("isa");
+      QTest::addColumn<int>("count");
+      QTest::newRow("scalar") << analyzer::instruction_set::scalar << 1003;
+      QTest::newRow("sse2") << analyzer::instruction_set::sse2 << 1003;
+      QTest::newRow("sse2 short") << analyzer::instruction_set::sse2 << 3;
+      QTest::newRow("avx2") << analyzer::instruction_set::avx2 << 1003;
+      QTest::newRow("avx2 short") << analyzer::instruction_set::avx2 << 7;
+      QTest::newRow("empty") << analyzer::instruction_set::avx2 << 0;
+    }
+
+    void calculate_overlaps() const
+    {
+      QFETCH(const analyzer::instruction_set, isa);
+      QFETCH(const int, count);
+      if (!analyzer::is_supported(isa))
+      {
+        QSKIP("This CPU does not support the instruction set.");
+      }
+      const auto [a, b] {make_box_pairs(static_cast<std::size_t>(count))};
+      analyzer::overlap_list overlaps(a.size());
+      analyzer::calculate_overlaps(a, b, overlaps, isa);
+      analyzer::overlap_list column_overlaps(a.size());
+      analyzer::calculate_overlaps(
+        analyzer::box_array {a}, analyzer::box_array {b}, column_overlaps, isa);
+      for (std::size_t i {0}; i < a.size(); ++i)
+      {
+        // The kernels promise bit-identical results, so compare the bits.
+        const auto expected {analyzer::calculate_overlap(a[i], b[i])};
+        QVERIFY2(std::memcmp(&expected, &overlaps[i], sizeof(expected)) == 0,
+                 qPrintable(QString {"pair %1: expected %2, got %3"}
+                              .arg(i)
+                              .arg(static_cast<double>(expected))
+                              .arg(static_cast<double>(overlaps[i]))));
+        QVERIFY2(
+          std::memcmp(&expected, &column_overlaps[i], sizeof(expected)) == 0,
+          qPrintable(QString {"box array pair %1: expected %2, got %3"}
+                       .arg(i)
+                       .arg(static_cast<double>(expected))
+                       .arg(static_cast<double>(column_overlaps[i]))));
+      }
+    }
+  };
+}  // namespace analyzer_test
+
+// NOLINTNEXTLINE(modernize-use-trailing-return-type)
+QTEST_APPLESS_MAIN(analyzer_test::overlap_kernels_test)
+#include "overlap_kernels_test.moc"
@@ -0,0 +1,111 @@
+#include "test_utilities.h"
+#include "tracking-analyzer/results_cache.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+namespace analyzer_test
+{
+  class results_cache_test final: public QObject
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  private slots:
+    void round_trip() const
+    {
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto path {
+        directory.filePath("nested/results.cache").toStdString()};
+      const analyzer::bounding_box_list deer {{1.0f, 2.0f, 3.0f, 4.0f},
+                                              {5.0f, 6.0f, 7.0f, 8.0f}};
+      const analyzer::bounding_box_list basketball {{9.0f, 8.0f, 7.0f, 6.0f}};
+      constexpr analyzer::file_stamp deer_stamp {16, 1000};
+      constexpr analyzer::file_stamp basketball_stamp {8, 2000};
+      analyzer::write_results_cache(
+        path,
+        {analyzer::cache_record {"MDNet/Deer.txt", deer_stamp, deer},
+         analyzer::cache_record {
+           "MDNet/Basketball.txt", basketball_stamp, basketball},
+         analyzer::cache_record {"MDNet/Empty.txt", {0, 0}, {}}});
+
+      const analyzer::results_cache cache {path};
+      QCOMPARE(cache.size(), 3ul);
+      QCOMPARE(cache.find("MDNet/Deer.txt", deer_stamp),
+               std::optional {deer});
+      QCOMPARE(cache.find("MDNet/Basketball.txt", basketball_stamp),
+               std::optional {basketball});
+      QCOMPARE(cache.find("MDNet/Empty.txt", {0, 0}),
+               std::optional {analyzer::bounding_box_list {}});
+    }
+
+    void stale_records_are_not_found() const
+    {
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto path {directory.filePath("results.cache").toStdString()};
+      const analyzer::bounding_box_list boxes {{1.0f, 2.0f, 3.0f, 4.0f}};
+      analyzer::write_results_cache(
+        path, {analyzer::cache_record {"MDNet/Deer.txt", {16, 1000}, boxes}});
+      const analyzer::results_cache cache {path};
+      QVERIFY(!cache.find("MDNet/Deer.txt", {17, 1000}));
+      QVERIFY(!cache.find("MDNet/Deer.txt", {16, 1001}));
+      QVERIFY(!cache.find("VITAL/Deer.txt", {16, 1000}));
+    }
+
+    void invalid_files_are_empty_caches_data() const
+    {
+      QTest::addColumn<QByteArray>("contents");
+      QTest::newRow("empty file") << QByteArray {};
+      QTest::newRow("text file") << QByteArray {"1,2,3,4\n"};
+      QTest::newRow("zeros") << QByteArray(256, '\0');
+    }
+
+    void invalid_files_are_empty_caches() const
+    {
+      QFETCH(const QByteArray, contents);
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto path {directory.filePath("results.cache")};
+      QFile file {path};
+      QVERIFY(file.open(QIODevice::WriteOnly));
+      file.write(contents);
+      file.close();
+      QCOMPARE(analyzer::results_cache {path.toStdString()}.size(), 0ul);
+    }
+
+    void truncated_file_is_an_empty_cache() const
+    {
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto path {directory.filePath("results.cache")};
+      analyzer::write_results_cache(
+        path.toStdString(),
+        {analyzer::cache_record {
+          "MDNet/Deer.txt", {16, 1000}, {{1.0f, 2.0f, 3.0f, 4.0f}}}});
+      QVERIFY(QFile::resize(path, QFileInfo {path}.size() - 1));
+      QCOMPARE(analyzer::results_cache {path.toStdString()}.size(), 0ul);
+    }
+
+    void missing_file_is_an_empty_cache() const
+    {
+      const analyzer::results_cache cache {"no_such_file.cache"};
+      QCOMPARE(cache.size(), 0ul);
+    }
+
+    void stamp_file() const
+    {
+      const auto stamp {
+        analyzer::stamp_file("test_metadata/tracking_results/MDNet/Deer.txt")};
+      QCOMPARE(stamp.size, std::int64_t {12});
+      QCOMPARE(analyzer::stamp_file("no_such_file.txt").size,
+               std::int64_t {-1});
+    }
+  };
+}  // namespace analyzer_test
+
+// NOLINTNEXTLINE(modernize-use-trailing-return-type)
+QTEST_APPLESS_MAIN(analyzer_test::results_cache_test)
+#include "results_cache_test.moc"
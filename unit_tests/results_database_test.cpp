@@ -1,5 +1,10 @@
+#include "test_utilities.h"
+#include "tracking-analyzer/results_cache.h"
 #include "tracking-analyzer/tracking_results.h"
+#include <QFileInfo>
+#include <QTemporaryDir>
 #include <QTest>
+#include <utility>
 
 using namespace std::literals::string_literals;
 
@@ -77,6 +82,37 @@ namespace analyzer_test
                                analyzer::invalid_tracker);
     }
 
+    void tracker_index_test() const
+    {
+      auto db {make_database()};
+      QCOMPARE(std::as_const(db).index_of("VITAL"), 1ul);
+      QCOMPARE(std::as_const(db).find("vital"), std::optional<std::size_t> {});
+      QVERIFY_EXCEPTION_THROWN(
+        [[maybe_unused]] const auto i {std::as_const(db).index_of("vital")},
+        analyzer::invalid_tracker);
+      QCOMPARE(&db[1], &db["VITAL"]);
+      db.trackers().emplace_back("TMFT",
+                                 analyzer::tracker_results::sequence_list {});
+      QCOMPARE(std::as_const(db).index_of("TMFT"), 2ul);
+      QVERIFY_EXCEPTION_THROWN([[maybe_unused]] const auto& t {db[3]},
+                               std::out_of_range);
+    }
+
+    void tracker_index_update_test() const
+    {
+      auto db {make_database()};
+      QCOMPARE(std::as_const(db).index_of("VITAL"), 1ul);
+      // Read-write access resets the index, so the replaced name is gone.
+      db[1] = analyzer::tracker_results {
+        "TMFT", analyzer::tracker_results::sequence_list {}};
+      QCOMPARE(std::as_const(db).index_of("TMFT"), 1ul);
+      QVERIFY(!std::as_const(db).find("VITAL"));
+      db["TMFT"] = analyzer::tracker_results {
+        "CREST", analyzer::tracker_results::sequence_list {}};
+      QCOMPARE(std::as_const(db).find("CREST"), std::optional {1ul});
+      QVERIFY(!std::as_const(db).find("TMFT"));
+    }
+
     void iteration_test() const
     {
       const auto db {make_database()};
@@ -87,6 +123,85 @@ namespace analyzer_test
         ++i;
       }
     }
+
+    void load_tracking_results_directory_data() const
+    {
+      QTest::addColumn<unsigned int>("worker_count");
+      QTest::newRow("one worker") << 1u;
+      QTest::newRow("four workers") << 4u;
+      QTest::newRow("default workers") << 0u;
+    }
+
+    void load_tracking_results_directory() const
+    {
+      QFETCH(const unsigned int, worker_count);
+      analyzer::load_error_list errors;
+      const auto db {analyzer::load_tracking_results_directory(
+        "test_metadata/tracking_results", worker_count, errors)};
+      QCOMPARE(analyzer::list_all_trackers(db), expected_names);
+      QCOMPARE(analyzer::size(db["MDNet"]), 2ul);
+      QCOMPARE(analyzer::size(db["VITAL"]), 2ul);
+      QCOMPARE(db["VITAL"][0].name(), "Basketball"s);
+      QCOMPARE(db["VITAL"][1].name(), "Deer"s);
+      QCOMPARE(db["MDNet"]["Basketball"].bounding_boxes(),
+               (analyzer::bounding_box_list {{1.0f, 2.0f, 3.0f, 4.0f},
+                                             {5.0f, 6.0f, 7.0f, 8.0f}}));
+      QCOMPARE(db["VITAL"]["Deer"].bounding_boxes(),
+               (analyzer::bounding_box_list {{10.0f, 20.0f, 30.0f, 40.0f}}));
+      QCOMPARE(errors.size(), 1ul);
+      QVERIFY(QString::fromStdString(errors.front().path)
+                .endsWith("VITAL/Broken.txt"));
+    }
+
+    void load_tracking_results_directory_with_cache() const
+    {
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto cache_path {directory.filePath("results.cache").toStdString()};
+      const std::string results_path {"test_metadata/tracking_results"};
+
+      // The first load parses every file and writes the cache.
+      analyzer::load_error_list errors;
+      const auto parsed {analyzer::load_tracking_results_directory(
+        results_path, cache_path, 2, errors)};
+      QVERIFY(QFileInfo::exists(QString::fromStdString(cache_path)));
+      QCOMPARE(errors.size(), 1ul);
+      QCOMPARE(analyzer::results_cache {cache_path}.size(), 4ul);
+
+      // The second load reads the same results from the cache.
+      errors.clear();
+      const auto cached {analyzer::load_tracking_results_directory(
+        results_path, cache_path, 2, errors)};
+      QCOMPARE(errors.size(), 1ul);
+      QCOMPARE(analyzer::list_all_trackers(cached), expected_names);
+      for (const auto& tracker : parsed)
+      {
+        for (const auto& sequence : tracker)
+        {
+          QCOMPARE(cached[tracker.name()][sequence.name()].bounding_boxes(),
+                   sequence.bounding_boxes());
+        }
+      }
+
+      // Prove the boxes come from the cache: cache different boxes with the
+      // current stamp of a source file.
+      const analyzer::bounding_box_list fake {{9.0f, 9.0f, 9.0f, 9.0f}};
+      analyzer::write_results_cache(
+        cache_path,
+        {analyzer::cache_record {
+          "MDNet/Deer.txt",
+          analyzer::stamp_file(results_path + "/MDNet/Deer.txt"),
+          fake}});
+      errors.clear();
+      const auto mixed {analyzer::load_tracking_results_directory(
+        results_path, cache_path, 2, errors)};
+      QCOMPARE(mixed["MDNet"]["Deer"].bounding_boxes(), fake);
+      QCOMPARE(mixed["VITAL"]["Deer"].bounding_boxes(),
+               parsed["VITAL"]["Deer"].bounding_boxes());
+
+      // The other files were parsed, so the cache was rewritten.
+      QCOMPARE(analyzer::results_cache {cache_path}.size(), 4ul);
+    }
   };
 }  // namespace analyzer_test
 
@@ -96,6 +96,67 @@ namespace analyzer_test
       QVERIFY_EXCEPTION_THROWN(results[2] = new_box, std::out_of_range);
     }
 
+    void box_columns_test() const
+    {
+      analyzer::sequence_results results {
+        "Deer", {{1.0f, 1.0f, 1.0f, 1.0f}, {2.0f, 2.0f, 2.0f, 2.0f}}};
+      const auto& read_only {results};
+      QCOMPARE(read_only.box_columns().size(), 2ul);
+      QCOMPARE(read_only.box_columns()[1], read_only[1]);
+      results[1] = analyzer::bounding_box {20.0f, 20.0f, 20.0f, 20.0f};
+      QCOMPARE(read_only.box_columns()[1], read_only[1]);
+      results.bounding_boxes().push_back({3.0f, 3.0f, 3.0f, 3.0f});
+      QCOMPARE(read_only.box_columns().size(), 3ul);
+    }
+
+    void box_columns_follow_held_reference_test() const
+    {
+      analyzer::sequence_results results {
+        "Deer", {{1.0f, 1.0f, 1.0f, 1.0f}, {2.0f, 2.0f, 2.0f, 2.0f}}};
+      const auto& read_only {results};
+      auto& boxes {results.bounding_boxes()};
+      const auto columns {read_only.box_columns()};
+      // Changing the boxes after reading the columns leaves the old columns
+      // intact, and the next read sees the change.
+      boxes.at(1) = analyzer::bounding_box {20.0f, 20.0f, 20.0f, 20.0f};
+      boxes.push_back({3.0f, 3.0f, 3.0f, 3.0f});
+      QCOMPARE(columns.size(), 2ul);
+      QCOMPARE(columns[1], (analyzer::bounding_box {2.0f, 2.0f, 2.0f, 2.0f}));
+      const auto changed {read_only.box_columns()};
+      QCOMPARE(changed.size(), 3ul);
+      QCOMPARE(changed[1], read_only[1]);
+      QCOMPARE(changed[2], read_only[2]);
+    }
+
+    void metrics_test() const
+    {
+      analyzer::sequence_results results {
+        "Deer", {{0.0f, 0.0f, 2.0f, 2.0f}, {0.0f, 0.0f, 2.0f, 2.0f}}};
+      const auto& read_only {results};
+      analyzer::box_array ground_truth {
+        {{0.0f, 0.0f, 2.0f, 2.0f}, {1.0f, 0.0f, 2.0f, 2.0f}}};
+      const auto* metrics {&read_only.metrics(ground_truth)};
+      QCOMPARE(metrics->overlaps, (analyzer::overlap_list {1.0f, 1.0f / 3.0f}));
+      QCOMPARE(metrics->offsets, (analyzer::offset_list {0.0f, 1.0f}));
+      QCOMPARE(&read_only.metrics(ground_truth), metrics);
+
+      results[1] = analyzer::bounding_box {1.0f, 0.0f, 2.0f, 2.0f};
+      metrics = &read_only.metrics(ground_truth);
+      QCOMPARE(metrics->overlaps, (analyzer::overlap_list {1.0f, 1.0f}));
+      QCOMPARE(metrics->offsets, (analyzer::offset_list {0.0f, 0.0f}));
+
+      ground_truth = analyzer::box_array {
+        {{0.0f, 0.0f, 2.0f, 2.0f}, {1.0f, 1.0f, 2.0f, 2.0f}}};
+      QCOMPARE(read_only.metrics(ground_truth).offsets[1], 0.0f);
+      results.reset_metrics();
+      QCOMPARE(read_only.metrics(ground_truth).offsets[1], 1.0f);
+
+      const analyzer::box_array too_short {{{0.0f, 0.0f, 2.0f, 2.0f}}};
+      results.reset_metrics();
+      QVERIFY_EXCEPTION_THROWN(
+        static_cast<void>(read_only.metrics(too_short)), std::invalid_argument);
+    }
+
     void size_test() const
     {
       analyzer::sequence_results results {"Deer", {}};
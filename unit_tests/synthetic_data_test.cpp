@@ -0,0 +1,170 @@
+#include "test_utilities.h"
+#include "tracking-analyzer/dataset.h"
+#include "tracking-analyzer/evaluation.h"
+#include "tracking-analyzer/synthetic_data.h"
+#include "tracking-analyzer/tracking_results.h"
+#include <QDir>
+#include <QTemporaryDir>
+#include <QTest>
+
+Q_DECLARE_METATYPE(analyzer::synthetic_options)  // NOLINT
+
+namespace analyzer_test
+{
+  namespace
+  {
+    auto make_options()
+    {
+      analyzer::synthetic_options options;
+      options.sequence_count = 3;
+      options.minimum_frame_count = 5;
+      options.maximum_frame_count = 20;
+      options.tracker_count = 2;
+      options.seed = 42;
+      return options;
+    }
+  }  // namespace
+
+  class synthetic_data_test final: public QObject
+  {
+    // NOLINTNEXTLINE(modernize-use-trailing-return-type)
+    Q_OBJECT
+
+  private slots:
+    void invalid_options_throw_data() const
+    {
+      QTest::addColumn<analyzer::synthetic_options>("options");
+      auto options {make_options()};
+      options.sequence_count = -1;
+      QTest::newRow("negative sequence count") << options;
+      options = make_options();
+      options.tracker_count = 1'000;
+      QTest::newRow("too many trackers") << options;
+      options = make_options();
+      options.minimum_frame_count = 0;
+      QTest::newRow("no frames") << options;
+      options = make_options();
+      options.maximum_frame_count = options.minimum_frame_count - 1;
+      QTest::newRow("maximum below minimum") << options;
+      options = make_options();
+      options.frame_height = 8;
+      QTest::newRow("small frames") << options;
+    }
+
+    void invalid_options_throw() const
+    {
+      QFETCH(const analyzer::synthetic_options, options);
+      QVERIFY_EXCEPTION_THROWN(
+        analyzer::write_synthetic_dataset(
+          QDir::temp().filePath("unused").toStdString(), options),
+        std::invalid_argument);
+      QVERIFY_EXCEPTION_THROWN(
+        const auto boxes {analyzer::make_synthetic_ground_truth(options, 0)},
+        std::invalid_argument);
+    }
+
+    void names_sort_in_index_order() const
+    {
+      QCOMPARE(analyzer::synthetic_sequence_name(42),
+               std::string {"sequence00042"});
+      QCOMPARE(analyzer::synthetic_tracker_name(7), std::string {"tracker007"});
+    }
+
+    void ground_truth_stays_in_frame() const
+    {
+      const auto options {make_options()};
+      for (int sequence {0}; sequence < options.sequence_count; ++sequence)
+      {
+        const auto boxes {
+          analyzer::make_synthetic_ground_truth(options, sequence)};
+        QVERIFY(boxes.size() >= 5 && boxes.size() <= 20);
+        for (const auto& box : boxes)
+        {
+          QVERIFY(box.x >= 0.0f && box.y >= 0.0f);
+          QVERIFY(box.width >= 1.0f && box.height >= 1.0f);
+          QVERIFY(box.x + box.width <= 640.0f);
+          QVERIFY(box.y + box.height <= 480.0f);
+        }
+      }
+      QVERIFY_EXCEPTION_THROWN(
+        const auto boxes {analyzer::make_synthetic_ground_truth(
+          options, options.sequence_count)},
+        std::invalid_argument);
+    }
+
+    void data_is_deterministic() const
+    {
+      auto options {make_options()};
+      const auto ground_truth {
+        analyzer::make_synthetic_ground_truth(options, 1)};
+      const auto results {
+        analyzer::make_synthetic_results(options, ground_truth, 1, 1)};
+      QCOMPARE(analyzer::make_synthetic_ground_truth(options, 1),
+               ground_truth);
+      QCOMPARE(analyzer::make_synthetic_results(options, ground_truth, 1, 1),
+               results);
+      options.tracker_count = 5;
+      QCOMPARE(analyzer::make_synthetic_ground_truth(options, 1),
+               ground_truth);
+      options.seed = 43;
+      QVERIFY(analyzer::make_synthetic_ground_truth(options, 1)
+              != ground_truth);
+    }
+
+    void results_start_at_ground_truth() const
+    {
+      const auto options {make_options()};
+      const auto ground_truth {
+        analyzer::make_synthetic_ground_truth(options, 0)};
+      const auto results {
+        analyzer::make_synthetic_results(options, ground_truth, 0, 0)};
+      QCOMPARE(results.size(), ground_truth.size());
+      QCOMPARE(results.front(), ground_truth.front());
+      QVERIFY_EXCEPTION_THROWN(
+        const auto boxes {analyzer::make_synthetic_results(
+          options, ground_truth, options.tracker_count, 0)},
+        std::invalid_argument);
+    }
+
+    void written_data_loads() const
+    {
+      const QTemporaryDir directory;
+      QVERIFY(directory.isValid());
+      const auto options {make_options()};
+      const auto dataset_path {directory.filePath("dataset")};
+      const auto results_path {directory.filePath("results").toStdString()};
+      analyzer::write_synthetic_dataset(dataset_path.toStdString(), options);
+      analyzer::write_synthetic_results(results_path, options);
+
+      analyzer::load_error_list skipped;
+      const auto data {analyzer::load_dataset(
+        dataset_path, analyzer::dataset_load_options {}, skipped)};
+      const auto results {
+        analyzer::load_tracking_results_directory(results_path, 0, skipped)};
+      QVERIFY(skipped.empty());
+      QCOMPARE(data.sequences().size(), options.sequence_count);
+      for (int i {0}; i < options.sequence_count; ++i)
+      {
+        const auto& sequence {data[i]};
+        QCOMPARE(sequence.name().toStdString(),
+                 analyzer::synthetic_sequence_name(i));
+        QCOMPARE(sequence.target_boxes(),
+                 analyzer::make_synthetic_ground_truth(options, i));
+        QCOMPARE(sequence.frame_count(),
+                 static_cast<int>(sequence.target_boxes().size()));
+        QVERIFY(!sequence.tags().isEmpty());
+      }
+      QCOMPARE(results.trackers().size(),
+               static_cast<std::size_t>(options.tracker_count));
+      const auto evaluations {analyzer::evaluate(results, data)};
+      QCOMPARE(evaluations.size(),
+               static_cast<std::size_t>(options.tracker_count));
+      QCOMPARE(evaluations.front().sequences.size(),
+               static_cast<std::size_t>(options.sequence_count));
+    }
+  };
+}  // namespace analyzer_test
+
+// NOLINTNEXTLINE(modernize-use-trailing-return-type)
+QTEST_APPLESS_MAIN(analyzer_test::synthetic_data_test)
+#include "synthetic_data_test.moc"
@@ -1,6 +1,7 @@
 #include "test_utilities.h"
 #include "tracking-analyzer/tracking_results.h"
 #include <QTest>
+#include <utility>
 
 using namespace std::literals::string_literals;
 
@@ -138,6 +139,29 @@ namespace analyzer_test
       QVERIFY_EXCEPTION_THROWN([[maybe_unused]] auto s {results["deer"].name()},
                                analyzer::invalid_sequence);
     }
+
+    void sequence_index_test() const
+    {
+      const auto results {make_tracker_results()};
+      QCOMPARE(results.find("Walking2"), std::optional {2ul});
+      QCOMPARE(results.find("walking2"), std::optional<std::size_t> {});
+      QCOMPARE(results.index_of("Deer"), 1ul);
+      QVERIFY_EXCEPTION_THROWN(
+        [[maybe_unused]] const auto i {results.index_of("deer")},
+        analyzer::invalid_sequence);
+    }
+
+    void sequence_index_update_test() const
+    {
+      auto results {make_tracker_results()};
+      QCOMPARE(std::as_const(results).index_of("Deer"), 1ul);
+      // Read-write access resets the index, so the replaced name is gone.
+      results[1] = analyzer::sequence_results {"David", expected_boxes};
+      QCOMPARE(std::as_const(results).index_of("David"), 1ul);
+      QVERIFY(!std::as_const(results).find("Deer"));
+      results.sequences().erase(std::begin(results.sequences()));
+      QCOMPARE(std::as_const(results).index_of("Walking2"), 1ul);
+    }
   };
 }  // namespace analyzer_test
 
@@ -1,8 +1,14 @@
 #include "tracking-analyzer/training_metadata.h"
+#include <QTemporaryFile>
 #include <QTest>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
 
 Q_DECLARE_METATYPE(analyzer::training_batch)   // NOLINT
 Q_DECLARE_METATYPE(analyzer::training_scores)  // NOLINT
+Q_DECLARE_METATYPE(analyzer::score_list)       // NOLINT
 
 namespace analyzer_test
 {
@@ -37,6 +43,23 @@ namespace analyzer_test
         compare(actual.at(i), expected.at(i));
       }
     }
+
+    // Write JSON to a temporary file, and get the file's path.
+    auto write_json(QTemporaryFile& file, const QByteArray& json)
+    {
+      if (!file.open() || file.write(json) != json.size() || !file.flush())
+      {
+        throw std::runtime_error {"Cannot write a temporary JSON file."};
+      }
+      return file.fileName();
+    }
+
+    // Nest an empty array in depth arrays, as the value of an unused member.
+    auto make_nested_json(const int depth)
+    {
+      return R"({"unused": )" + QByteArray(depth, '[') + QByteArray(depth, ']')
+             + R"(, "sequence": "Deer", "data": {}})";
+    }
   }  // namespace
 
   class training_metadata_test final: public QObject
@@ -51,6 +74,7 @@ namespace analyzer_test
       QTest::newRow("empty path") << "";
       QTest::newRow("file does not exist") << "no_such_file.json";
       QTest::newRow("invalid JSON") << "invalid_training_metadata.json";
+      QTest::newRow("not JSON") << "test_metadata/invalid.json";
     }
 
     void load_training_scores_throws() const
@@ -228,6 +252,136 @@ namespace analyzer_test
       compare(actual_scores.updates, expected_scores.updates);
     }
 
+    void load_training_scores_reads_json_data() const
+    {
+      QTest::addColumn<QByteArray>("json");
+      QTest::addColumn<QString>("sequence_name");
+      QTest::addColumn<std::vector<int>>("update_frames");
+      QTest::addColumn<std::vector<int>>("batch_counts");
+      QTest::newRow("string escapes")
+        << QByteArray {R"({"sequence": "a\"b\\c\/d\b\f\n\r\t\u00e9"})"}
+        << QString {"a\"b\\c/d\b\f\n\r\t"} + QChar {0x00e9}
+        << std::vector<int> {} << std::vector<int> {};
+      QTest::newRow("surrogate pair")
+        << QByteArray {R"({"sequence": "\ud83d\ude00"})"}
+        << QString::fromUtf8("\xf0\x9f\x98\x80") << std::vector<int> {}
+        << std::vector<int> {};
+      QTest::newRow("unknown members are skipped")
+        << QByteArray {R"({"meta": {"a": [1, {"b": [true, false, null]}],)"
+                       R"( "c": "}]"}, "sequence": "Deer", "data": {"0":)"
+                       R"( [{"extra": [[1, 2], {"x": {}}], "more": -1e3}]}})"}
+        << QString {"Deer"} << std::vector<int> {0} << std::vector<int> {1};
+      QTest::newRow("deep nesting in skipped members")
+        << make_nested_json(200) << QString {"Deer"} << std::vector<int> {}
+        << std::vector<int> {};
+      // QJsonObject kept only one member for each key. The reader keeps every
+      // update, so none of the file's data is lost.
+      QTest::newRow("duplicate updates are kept")
+        << QByteArray {R"({"sequence": "Deer", "data": {"20": [{}],)"
+                       R"( "0": [{}], "20": [{}, {}]}})"}
+        << QString {"Deer"} << std::vector<int> {0, 20, 20}
+        << std::vector<int> {1, 1, 2};
+      QTest::newRow("the last duplicate name wins")
+        << QByteArray {R"({"sequence": "Bolt", "sequence": "Deer"})"}
+        << QString {"Deer"} << std::vector<int> {} << std::vector<int> {};
+    }
+
+    void load_training_scores_reads_json() const
+    {
+      QFETCH(const QByteArray, json);
+      QTemporaryFile file;
+      const auto scores {
+        analyzer::load_training_scores(write_json(file, json))};
+      QTEST(scores.sequence_name, "sequence_name");
+      QTEST(scores.update_frames, "update_frames");
+      std::vector<int> batch_counts;
+      for (const auto& update : scores.updates)
+      {
+        batch_counts.push_back(static_cast<int>(update.size()));
+      }
+      QTEST(batch_counts, "batch_counts");
+    }
+
+    void invalid_json_throws_data() const
+    {
+      QTest::addColumn<QByteArray>("json");
+      QTest::newRow("truncated in a value")
+        << QByteArray {R"({"sequence": "Deer", "data": {"0": [{"thresholds":)"
+                       R"( [1)"};
+      QTest::newRow("truncated in a string")
+        << QByteArray {R"({"sequence": "De)"};
+      QTest::newRow("truncated in an escape")
+        << QByteArray {R"({"sequence": "\u00)"};
+      QTest::newRow("trailing data")
+        << QByteArray {R"({"sequence": "Deer", "data": {}} {})"};
+      QTest::newRow("nested too deeply") << make_nested_json(300);
+      QTest::newRow("invalid escape")
+        << QByteArray {R"({"sequence": "\x"})"};
+      QTest::newRow("invalid \\u escape")
+        << QByteArray {R"({"sequence": "\u12g4"})"};
+      QTest::newRow("unpaired high surrogate")
+        << QByteArray {R"({"sequence": "\ud83d\n"})"};
+      QTest::newRow("invalid literal")
+        << QByteArray {R"({"unused": nul, "sequence": "Deer"})"};
+    }
+
+    void invalid_json_throws() const
+    {
+      QFETCH(const QByteArray, json);
+      QTemporaryFile file;
+      const auto path {write_json(file, json)};
+      QVERIFY_EXCEPTION_THROWN(
+        static_cast<void>(analyzer::load_training_scores(path)),
+        analyzer::parse_error);
+      QVERIFY_EXCEPTION_THROWN(analyzer::training_score_index {path},
+                               analyzer::parse_error);
+    }
+
+    void training_score_index_throws() const
+    {
+      QVERIFY_EXCEPTION_THROWN(analyzer::training_score_index {""},
+                               std::invalid_argument);
+      QVERIFY_EXCEPTION_THROWN(
+        analyzer::training_score_index {"test_metadata/invalid.json"},
+        std::exception);
+    }
+
+    void training_score_index() const
+    {
+      analyzer::training_score_index index {
+        "test_metadata/training_metadata/full.json"};
+      QCOMPARE(index.sequence_name(), QString {"Deer"});
+      QCOMPARE(index.dataset(), QString {"OTB-100"});
+      QCOMPARE(index.update_frames(), (std::vector<int> {0, 20}));
+      QCOMPARE(index.update_count(), std::size_t {2});
+      QCOMPARE(index.batch_count(0), std::size_t {1});
+      QCOMPARE(index.batch_count(1), std::size_t {1});
+      QCOMPARE(index.cached_batch_count(), std::size_t {0});
+
+      const auto expected {analyzer::load_training_scores(
+        "test_metadata/training_metadata/full.json")};
+      compare(index.batch({1, 0}), expected.updates.at(1).at(0));
+      compare(index.batch({0, 0}), expected.updates.at(0).at(0));
+      QCOMPARE(index.cached_batch_count(), std::size_t {2});
+      QVERIFY_EXCEPTION_THROWN(const auto& batch {index.batch({2, 0})},
+                               std::out_of_range);
+      QVERIFY_EXCEPTION_THROWN(const auto& batch {index.batch({0, 1})},
+                               std::out_of_range);
+    }
+
+    void training_score_index_evicts_batches() const
+    {
+      analyzer::training_score_index index {
+        "test_metadata/training_metadata/full.json", 1};
+      const auto expected {analyzer::load_training_scores(
+        "test_metadata/training_metadata/full.json")};
+      compare(index.batch({0, 0}), expected.updates.at(0).at(0));
+      compare(index.batch({1, 0}), expected.updates.at(1).at(0));
+      QCOMPARE(index.cached_batch_count(), std::size_t {1});
+      compare(index.batch({0, 0}), expected.updates.at(0).at(0));
+      QCOMPARE(index.cached_batch_count(), std::size_t {1});
+    }
+
     void get_chart_range_data() const
     {
       QTest::addColumn<analyzer::training_batch>("batch");
@@ -259,6 +413,12 @@ namespace analyzer_test
                                      20.0f,
                                      -20.0f}
         << analyzer::range {-20.0f, 20.0f};
+      QTest::newRow("empty lists don't include 0") << analyzer::training_batch {
+        analyzer::score_list {{10.0f, 20.0f}, {30.0f, 40.0f}},
+        analyzer::score_list {},
+        analyzer::score_list {},
+        15.0f,
+        25.0f} << analyzer::range {10.0f, 40.0f};
     }
 
     void get_chart_range() const
@@ -266,6 +426,71 @@ namespace analyzer_test
       QFETCH(const analyzer::training_batch, batch);
       QTEST(analyzer::get_chart_range(batch), "expected_range");
     }
+
+    void score_list_stores_columns() const
+    {
+      const analyzer::score_list scores {{1.0, -2.0}, {3.5, 4.0}, {-5.0, 6.0}};
+      QCOMPARE(scores.size(), std::size_t {3});
+      QCOMPARE(scores[1], (QPointF {3.5, 4.0}));
+      QVERIFY(std::equal(std::begin(scores.x()),
+                         std::end(scores.x()),
+                         std::begin({1.0f, 3.5f, -5.0f})));
+      QVERIFY(std::equal(std::begin(scores.y()),
+                         std::end(scores.y()),
+                         std::begin({-2.0f, 4.0f, 6.0f})));
+      constexpr auto alignment {analyzer::box_array::alignment};
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      QCOMPARE(reinterpret_cast<std::uintptr_t>(scores.x().data()) % alignment,
+               std::uintptr_t {0});
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      QCOMPARE(reinterpret_cast<std::uintptr_t>(scores.y().data()) % alignment,
+               std::uintptr_t {0});
+      QCOMPARE(scores.to_points(),
+               (QVector<QPointF> {{1.0, -2.0}, {3.5, 4.0}, {-5.0, 6.0}}));
+      QVERIFY_EXCEPTION_THROWN(const auto score {scores[3]},
+                               std::out_of_range);
+    }
+
+    void get_score_range_data() const
+    {
+      QTest::addColumn<analyzer::score_list>("scores");
+      QTest::addColumn<analyzer::range>("expected_range");
+      QTest::newRow("empty") << analyzer::score_list {}
+                             << analyzer::range {0.0f, 0.0f};
+      QTest::newRow("one score") << analyzer::score_list {{3.0f, -2.0f}}
+                                 << analyzer::range {-2.0f, 3.0f};
+      QTest::newRow("even count")
+        << analyzer::score_list {{1.0f, 2.0f},
+                                 {-8.0f, 4.0f},
+                                 {5.0f, 6.0f},
+                                 {7.0f, 9.0f}}
+        << analyzer::range {-8.0f, 9.0f};
+      QTest::newRow("odd count, extremes last")
+        << analyzer::score_list {{1.0f, 2.0f},
+                                 {3.0f, 4.0f},
+                                 {5.0f, 6.0f},
+                                 {7.0f, 8.0f},
+                                 {-10.0f, 12.0f}}
+        << analyzer::range {-10.0f, 12.0f};
+    }
+
+    void get_score_range() const
+    {
+      QFETCH(const analyzer::score_list, scores);
+      QTEST(analyzer::get_chart_range(scores), "expected_range");
+    }
+
+    void loaded_batches_cache_chart_range() const
+    {
+      const auto scores {analyzer::load_training_scores(
+        "test_metadata/training_metadata/full.json")};
+      auto batch {scores.updates.at(1).at(0)};
+      QVERIFY(batch.chart_range.has_value());
+      QCOMPARE(*batch.chart_range, (analyzer::range {-109.0f, 122.0f}));
+      batch.chart_range.reset();
+      QCOMPARE(analyzer::get_chart_range(batch),
+               (analyzer::range {-109.0f, 122.0f}));
+    }
   };
 }  // namespace analyzer_test
 